@@ -13,6 +13,28 @@
 #include <Wire.h>
 #define wire Wire
 
+// the bus transports
+#include <IS31FL3731_transport.h>
+
+
+// the number of bytes the wire library can send or receive in one transaction, including the register address.
+// worked out from the core's wire library, define it yourself to override.
+#ifndef IS31FL3731_WIRE_BUFFER_SIZE
+    #if defined( I2C_BUFFER_LENGTH )
+        // esp32 and esp8266 cores
+        #define IS31FL3731_WIRE_BUFFER_SIZE I2C_BUFFER_LENGTH
+    #elif defined( WIRE_BUFFER_SIZE )
+        // rp2040 core
+        #define IS31FL3731_WIRE_BUFFER_SIZE WIRE_BUFFER_SIZE
+    #elif defined( BUFFER_LENGTH )
+        // avr, megaavr and the cores that copied them
+        #define IS31FL3731_WIRE_BUFFER_SIZE BUFFER_LENGTH
+    #else
+        // play it safe
+        #define IS31FL3731_WIRE_BUFFER_SIZE 32
+    #endif
+#endif
+
 
 
 
@@ -29,6 +51,19 @@
 #define IS31FL3731_ADDRESS_PICTURE_DISPLAY_REG 0x01
 #define IS31FL3731_ADDRESS_SOFTWARESHUTDOWN 0x0A
 
+// status codes.  1-4 come straight from endTransmission().
+#define IS31FL3731_OK 0
+#define IS31FL3731_ERROR_DATA_TOO_LONG 1
+#define IS31FL3731_ERROR_ADDRESS_NACK 2
+#define IS31FL3731_ERROR_DATA_NACK 3
+#define IS31FL3731_ERROR_OTHER 4
+#define IS31FL3731_ERROR_TIMEOUT 5
+
+// how long a read waits for the chip by default, in microseconds.
+#ifndef IS31FL3731_DEFAULT_TIMEOUT_US
+#define IS31FL3731_DEFAULT_TIMEOUT_US 1000
+#endif
+
 
 
 
@@ -39,17 +74,49 @@
 
 
 
-class IS31FL3731 {
+/// @brief Driver for the IS31FL3731, over any bus transport.
+/// See IS31FL3731_transport.h for what a transport needs.  Use IS31FL3731 for the usual Wire bus.
+template< class Transport >
+class IS31FL3731T {
 private:
+    /// @brief The bus to talk to the chip over.
+    Transport _transport;
+
     /// @brief i2c address of chip
     uint8_t _i2c_address;
 
+    /// @brief How long a read may wait for the chip, in microseconds.
+    uint32_t _timeout;
+
+    /// @brief The result of the last bus transaction.
+    uint8_t _laststatus;
+
+    /// @brief The page the chip has selected, 0xFF if we don't know.
+    uint8_t _currentpage;
+
+    /// @brief Select the page for the next register access, if it is not selected already.
+    /// @param page The page to select, 0x0-7 animation, 0xB control.
+    /// @return IS31FL3731_OK, or an error code.
+    uint8_t _pageselect( uint8_t page );
+
+    /// @brief Point the chip at a register, ready to read from it.
+    /// @param page The page to read from.  0x0-7 animation, 0xB control.
+    /// @param address The address within the page.
+    /// @return IS31FL3731_OK, or an error code.
+    uint8_t _readstart( uint8_t page , uint8_t address );
+
+    /// @brief Read bytes back from wherever the chip's address pointer is.  Never waits longer than the timeout.
+    /// @param data Where to put the bytes.
+    /// @param count How many bytes to read.  No more than the wire buffer size.
+    /// @return IS31FL3731_OK, or an error code.
+    uint8_t _busread( uint8_t *data , uint8_t count );
+
 
 
 public:
     /// @brief Constructor for IS31FL3731 LED matrix driver.
-    /// @param address I2C address of the chip.
-    IS31FL3731();
+    /// @param transport The bus to talk to the chip over.
+    IS31FL3731T( const Transport &transport = Transport() );
 
 
     /// @brief Set the i2c address of the chip.
@@ -66,20 +133,59 @@ public:
     /// @param page The page to write to, 0x0-7 animation, 0xB control.
     /// @param address The address within the page to write to.
     /// @param data The data to write
-    void write( uint8_t page , uint8_t address , uint8_t data );
+    /// @return IS31FL3731_OK, or an error code.
+    uint8_t write( uint8_t page , uint8_t address , uint8_t data );
 
-    /// @brief Read a byte from the chip
+    /// @brief Read a byte from the chip.  Never waits longer than the timeout.
     /// @param page The page to read from.  0x0-7 animation, 0xB control.
     /// @param address The address within the page to write to.
+    /// @return The byte read, or 0 on failure.  laststatusget() tells you which.
     uint8_t read( uint8_t page , uint8_t address );
 
 
+    /// @brief Write a run of registers, the chip auto increments the address.
+    /// Split into as few transactions as the wire buffer allows.
+    /// @param page The page to write to, 0x0-7 animation, 0xB control.
+    /// @param start The address of the first register.
+    /// @param data The bytes to write.
+    /// @param len How many bytes to write.
+    /// @return IS31FL3731_OK, or an error code.
+    uint8_t writeBurst( uint8_t page , uint8_t start , const uint8_t *data , uint8_t len );
+
+    /// @brief Read a run of registers, the chip auto increments the address.
+    /// One address write, then as few reads as the wire buffer allows.
+    /// @param page The page to read from.  0x0-7 animation, 0xB control.
+    /// @param start The address of the first register.
+    /// @param data Where to put the bytes.
+    /// @param len How many bytes to read.
+    /// @return IS31FL3731_OK, or an error code.
+    uint8_t readBurst( uint8_t page , uint8_t start , uint8_t *data , uint8_t len );
+
+
+    /// @brief Forget which page the chip has selected, so the next access selects it again.
+    /// Use this if something else has talked to the chip.
+    void pageinvalidate();
+
+
+    /// @brief Set how long a read may wait for the chip before giving up.
+    /// The wire library gets the same timeout where it supports one, so a stuck write gives up too.
+    /// @param microseconds The timeout in microseconds.
+    void timeoutset( uint32_t microseconds );
+
+    /// @brief Returns the read timeout in microseconds.
+    uint32_t timeoutget();
+
+    /// @brief Returns the result of the last bus transaction.  IS31FL3731_OK or an error code.
+    uint8_t laststatusget();
+
+
 
 
     
     /// @brief Sets the software shutdown state to 0 ( shutdown ) or 1 ( normal operation ). 
     /// @param state 0 or 1. 0 is shutdown, 1 is normal operation.
-    void shutdownset( uint8_t state );
+    /// @return IS31FL3731_OK, or an error code.
+    uint8_t shutdownset( uint8_t state );
 
     /// @brief Retreives the current software shutdown state.
     uint8_t shutdownget();
@@ -87,7 +193,8 @@ public:
 
     /// @brief Set the mode in the configuration register.
     /// @param mode 0b00 = picture mode, 0b01 = auto frame play, 0b1x = audio frame play.
-    void modeset( uint8_t mode );
+    /// @return IS31FL3731_OK, or an error code.  Nothing is written if the config register could not be read.
+    uint8_t modeset( uint8_t mode );
     
     /// @brief Gets the current mode from the chip.
     uint8_t modeget();
@@ -95,7 +202,8 @@ public:
 
     /// @brief Set the current frame number to display.
     /// @param frame the number of the frame to display.  0-7.
-    void frameset( uint8_t frame );
+    /// @return IS31FL3731_OK, or an error code.
+    uint8_t frameset( uint8_t frame );
 
     /// @brief returns the current frame number from the chip.
     uint8_t frameget();
@@ -116,6 +224,14 @@ public:
 
 
 
+// the driver for the usual Wire bus, built once in IS31FL3731.cpp.
+extern template class IS31FL3731T< IS31FL3731WireTransport >;
+typedef IS31FL3731T< IS31FL3731WireTransport > IS31FL3731;
+
+
+
+
+
 
 
 
@@ -0,0 +1,388 @@
+#ifndef IS31FL3731_IMPL_HEADER_GUARD
+#define IS31FL3731_IMPL_HEADER_GUARD
+
+
+// IS31FL3731 library code
+// IS31FL3731.cpp builds it for the default wire transport, include this yourself to build it for another transport.
+#include <IS31FL3731.h>
+
+
+/// @brief Constructor for IS31FL3731 LED matrix driver.
+/// @param transport The bus to talk to the chip over.
+template< class Transport >
+IS31FL3731T< Transport >::IS31FL3731T( const Transport &transport ) : _transport( transport ) {
+
+    // _i2c_address = ( address & 0b01111111 );
+
+    _timeout = IS31FL3731_DEFAULT_TIMEOUT_US;
+    _laststatus = IS31FL3731_OK;
+    _currentpage = 0xFF;
+
+}
+
+
+
+
+
+/// @brief Set the i2c address of the chip.
+/// @param _i2c_address The i2c address of the chip.
+template< class Transport >
+void IS31FL3731T< Transport >::i2caddressset( uint8_t new_i2c_address ) {
+
+    _i2c_address = ( new_i2c_address & 0b01111111 );
+
+    // a different chip may have a different page selected
+    _currentpage = 0xFF;
+
+    // the bus times out stuck transactions too, where the wire library can
+    _transport.timeoutSet( _timeout );
+    
+}
+
+/// @brief  Returns the current i2c address as a uint8_t
+template< class Transport >
+uint8_t IS31FL3731T< Transport >::i2caddressget() {
+
+    return _i2c_address;
+
+}
+
+
+
+
+/// @brief Select the page for the next register access, if it is not selected already.
+/// @param page The page to select, 0x0-7 animation, 0xB control.
+/// @return IS31FL3731_OK, or an error code.
+template< class Transport >
+uint8_t IS31FL3731T< Transport >::_pageselect( uint8_t page ) {
+
+    // already there?
+    if ( page == _currentpage ) { return IS31FL3731_OK; }
+
+    // say hello to the chip
+    _transport.beginTransmission( _i2c_address );
+
+    // send the page
+    _transport.write( 0xFD );
+    _transport.write( page );
+
+    // say goodbye, and remember how it went
+    _laststatus = _transport.endTransmission();
+
+    // if that failed we no longer know which page is selected.
+    _currentpage = _laststatus ? 0xFF : page;
+
+    return _laststatus;
+
+}
+
+
+/// @brief Point the chip at a register, ready to read from it.
+/// @param page The page to read from.  0x0-7 animation, 0xB control.
+/// @param address The address within the page.
+/// @return IS31FL3731_OK, or an error code.
+template< class Transport >
+uint8_t IS31FL3731T< Transport >::_readstart( uint8_t page , uint8_t address ) {
+
+    // select the page first
+    if ( _pageselect( page ) ) { return _laststatus; }
+
+    _transport.beginTransmission( _i2c_address );
+    
+    // send the address
+    _transport.write( address );
+
+    // say goodye to the chip
+    _laststatus = _transport.endTransmission();
+
+    return _laststatus;
+
+}
+
+
+/// @brief Read bytes back from wherever the chip's address pointer is.  Never waits longer than the timeout.
+/// @param data Where to put the bytes.
+/// @param count How many bytes to read.  No more than the wire buffer size.
+/// @return IS31FL3731_OK, or an error code.
+template< class Transport >
+uint8_t IS31FL3731T< Transport >::_busread( uint8_t *data , uint8_t count ) {
+
+    // request the bytes back from the chip, nothing comes back if the chip did not answer
+    if ( _transport.requestFrom( _i2c_address , count ) == 0 ) {
+
+        _laststatus = IS31FL3731_ERROR_ADDRESS_NACK;
+        return _laststatus;
+
+    }
+
+    // wait for them, but not forever
+    uint32_t starttime = micros();
+
+    while( _transport.available() < count ) {
+
+        if ( ( micros() - starttime ) > _timeout ) {
+
+            _laststatus = IS31FL3731_ERROR_TIMEOUT;
+            return _laststatus;
+
+        }
+
+    }
+
+    // receive them
+    for ( uint8_t i = 0 ; i < count ; i++ ) {
+
+        data[ i ] = (uint8_t)( _transport.read() );
+
+    }
+
+    _laststatus = IS31FL3731_OK;
+    return _laststatus;
+
+}
+
+
+
+
+
+/// @brief Write a byte to the chip
+/// @param page The page to write to, 0x0-7 animation, 0xB control.
+/// @param address The address within the page to write to.
+/// @param data The data to write
+/// @return IS31FL3731_OK, or an error code.
+template< class Transport >
+uint8_t IS31FL3731T< Transport >::write( uint8_t page , uint8_t address , uint8_t data ) {
+
+    // a burst of one
+    return writeBurst( page , address , &data , 1 );
+
+}
+
+
+
+
+
+
+/// @brief Read a byte from the chip.  Never waits longer than the timeout.
+/// @param page The page to read from.  0x0-7 animation, 0xB control.
+/// @param address The address within the page to write to.
+/// @return The byte read, or 0 on failure.  laststatusget() tells you which.
+template< class Transport >
+uint8_t IS31FL3731T< Transport >::read( uint8_t page , uint8_t address ) { 
+    
+    uint8_t data = 0;
+
+    // a burst of one
+    if ( readBurst( page , address , &data , 1 ) ) { return 0; }
+
+    return data;
+    
+}
+
+
+
+
+
+/// @brief Write a run of registers, the chip auto increments the address.
+/// @param page The page to write to, 0x0-7 animation, 0xB control.
+/// @param start The address of the first register.
+/// @param data The bytes to write.
+/// @param len How many bytes to write.
+/// @return IS31FL3731_OK, or an error code.
+template< class Transport >
+uint8_t IS31FL3731T< Transport >::writeBurst( uint8_t page , uint8_t start , const uint8_t *data , uint8_t len ) {
+
+    // select the page first
+    if ( _pageselect( page ) ) { return _laststatus; }
+
+    while ( len ) {
+
+        // one byte of the wire buffer goes on the register address
+        uint8_t count = len;
+        if ( count > ( IS31FL3731_WIRE_BUFFER_SIZE - 1 ) ) { count = IS31FL3731_WIRE_BUFFER_SIZE - 1; }
+
+        // say hello to the chip
+        _transport.beginTransmission( _i2c_address );
+
+        // send the address
+        _transport.write( start );
+
+        // send the data
+        for ( uint8_t i = 0 ; i < count ; i++ ) { _transport.write( data[ i ] ); }
+
+        // say goodbye
+        _laststatus = _transport.endTransmission();
+        if ( _laststatus ) { _currentpage = 0xFF; return _laststatus; }
+
+        // on to the next lot
+        start += count;
+        data += count;
+        len -= count;
+
+    }
+
+    // all done, return to caller
+    return IS31FL3731_OK;
+
+}
+
+
+/// @brief Read a run of registers, the chip auto increments the address.
+/// @param page The page to read from.  0x0-7 animation, 0xB control.
+/// @param start The address of the first register.
+/// @param data Where to put the bytes.
+/// @param len How many bytes to read.
+/// @return IS31FL3731_OK, or an error code.
+template< class Transport >
+uint8_t IS31FL3731T< Transport >::readBurst( uint8_t page , uint8_t start , uint8_t *data , uint8_t len ) {
+
+    // point the chip at the first register, it carries on counting across reads
+    if ( _readstart( page , start ) ) { _currentpage = 0xFF; return _laststatus; }
+
+    while ( len ) {
+
+        uint8_t count = len;
+        if ( count > IS31FL3731_WIRE_BUFFER_SIZE ) { count = IS31FL3731_WIRE_BUFFER_SIZE; }
+
+        if ( _busread( data , count ) ) { _currentpage = 0xFF; return _laststatus; }
+
+        // on to the next lot
+        data += count;
+        len -= count;
+
+    }
+
+    // all done, return to caller
+    return IS31FL3731_OK;
+
+}
+
+
+/// @brief Forget which page the chip has selected, so the next access selects it again.
+template< class Transport >
+void IS31FL3731T< Transport >::pageinvalidate() {
+
+    _currentpage = 0xFF;
+
+}
+
+
+
+
+
+/// @brief Set how long a read may wait for the chip before giving up.
+/// @param microseconds The timeout in microseconds.
+template< class Transport >
+void IS31FL3731T< Transport >::timeoutset( uint32_t microseconds ) {
+
+    _timeout = microseconds;
+    _transport.timeoutSet( _timeout );
+
+}
+
+/// @brief Returns the read timeout in microseconds.
+template< class Transport >
+uint32_t IS31FL3731T< Transport >::timeoutget() {
+
+    return _timeout;
+
+}
+
+/// @brief Returns the result of the last bus transaction.  IS31FL3731_OK or an error code.
+template< class Transport >
+uint8_t IS31FL3731T< Transport >::laststatusget() {
+
+    return _laststatus;
+
+}
+
+
+
+
+
+
+/// @brief Sets the software shutdown state to 0 ( shutdown ) or 1 ( normal operation ). 
+/// @param state 0 or 1. 0 is shutdown, 1 is normal operation.
+/// @return IS31FL3731_OK, or an error code.
+template< class Transport >
+uint8_t IS31FL3731T< Transport >::shutdownset( uint8_t state ) {
+
+    // write the data to the chip
+    return write( IS31FL3731_PAGE_CONTROL , IS31FL3731_ADDRESS_SOFTWARESHUTDOWN , state );
+
+}
+
+
+
+
+
+
+
+/// @brief Retreives the current software shutdown state as a uint8_t.
+template< class Transport >
+uint8_t IS31FL3731T< Transport >::shutdownget() {
+
+    return read( IS31FL3731_PAGE_CONTROL , IS31FL3731_ADDRESS_SOFTWARESHUTDOWN );
+
+}
+
+
+
+
+
+/// @brief Set the mode in the configuration register.
+/// @param mode 0b00 = picture mode, 0b01 = auto frame play, 0b1x = audio frame play.
+/// @return IS31FL3731_OK, or an error code.  Nothing is written if the config register could not be read.
+template< class Transport >
+uint8_t IS31FL3731T< Transport >::modeset( uint8_t mode ) {
+
+    // read out the current config register byte, writing back a guess would clobber the other bits
+    uint8_t tempbyte = 0;
+    if ( readBurst( IS31FL3731_PAGE_CONTROL , IS31FL3731_ADDRESS_CONFIG_REGISTER , &tempbyte , 1 ) ) { return _laststatus; }
+
+    // add in my data
+    tempbyte &= 0b11100111;
+    tempbyte |= ( mode << 3 );
+    
+    // write back the completed register byte, and return to caller!
+    return write( IS31FL3731_PAGE_CONTROL , IS31FL3731_ADDRESS_CONFIG_REGISTER , tempbyte );
+
+}
+
+/// @brief Gets the current mode from the chip.
+template< class Transport >
+uint8_t IS31FL3731T< Transport >::modeget() {
+
+    uint8_t tempbyte = read( IS31FL3731_PAGE_CONTROL , IS31FL3731_ADDRESS_CONFIG_REGISTER );
+
+    tempbyte &= 0b00011000;
+
+    return ( tempbyte >> 3 );
+
+}
+
+
+
+
+
+
+
+
+/// @brief Set the current frame number to display.
+/// @param frame the number of the frame to display.  0-7.
+/// @return IS31FL3731_OK, or an error code.
+template< class Transport >
+uint8_t IS31FL3731T< Transport >::frameset( uint8_t frame ) {
+    return write( IS31FL3731_PAGE_CONTROL , IS31FL3731_ADDRESS_PICTURE_DISPLAY_REG , frame );
+}
+
+/// @brief returns the current frame number from the chip.
+template< class Transport >
+uint8_t IS31FL3731T< Transport >::frameget() {
+    return read( IS31FL3731_PAGE_CONTROL , IS31FL3731_ADDRESS_PICTURE_DISPLAY_REG );
+}
+
+
+
+
+#endif
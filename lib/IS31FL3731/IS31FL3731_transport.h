@@ -0,0 +1,84 @@
+#ifndef IS31FL3731_TRANSPORT_HEADER_GUARD
+#define IS31FL3731_TRANSPORT_HEADER_GUARD
+
+
+// bus transports for the IS31FL3731 library
+//
+// the driver is a template over its transport, so every bus call is a plain inlined call, no virtuals.
+// any class with these members will do:
+//
+//   void timeoutSet( uint32_t microseconds );                 time out stuck transactions, if the bus can
+//   void beginTransmission( uint8_t address );                start a write
+//   void write( uint8_t data );                               queue a byte to write
+//   uint8_t endTransmission();                                send it, 0 on success, wire library codes on failure
+//   uint8_t requestFrom( uint8_t address , uint8_t count );   read bytes, returns how many came back
+//   int available();                                          bytes waiting to be read
+//   int read();                                               next byte read
+
+// include Arduino header
+#include <Arduino.h>
+
+// Wire library
+#include <Wire.h>
+
+
+
+
+/// @brief Transport over a TwoWire bus, Wire unless told otherwise.
+class IS31FL3731WireTransport {
+private:
+    /// @brief The bus to talk over.
+    TwoWire *_bus;
+
+
+
+public:
+    /// @brief Constructor for the wire transport.
+    /// @param bus The bus to talk over.
+    IS31FL3731WireTransport( TwoWire &bus = Wire ) : _bus( &bus ) {}
+
+
+    /// @brief Have the bus give up on a transaction the chip is holding up, if the wire library can.
+    /// @param microseconds The timeout in microseconds.
+    void timeoutSet( uint32_t microseconds ) {
+
+        #if defined( WIRE_HAS_TIMEOUT )
+        _bus->setWireTimeout( microseconds , true );
+        #else
+        (void)( microseconds );
+        #endif
+
+    }
+
+
+    /// @brief Start a write transaction.
+    /// @param address The i2c address of the chip.
+    void beginTransmission( uint8_t address ) { _bus->beginTransmission( address ); }
+
+    /// @brief Queue a byte to write.
+    /// @param data The byte.
+    void write( uint8_t data ) { _bus->write( data ); }
+
+    /// @brief Send the queued bytes.
+    /// @return 0 on success, otherwise the wire library error code.
+    uint8_t endTransmission() { return _bus->endTransmission(); }
+
+    /// @brief Read bytes from the chip.
+    /// @param address The i2c address of the chip.
+    /// @param count How many bytes to read.
+    /// @return How many bytes came back.
+    uint8_t requestFrom( uint8_t address , uint8_t count ) { return _bus->requestFrom( address , count ); }
+
+    /// @brief How many bytes are waiting to be read.
+    int available() { return _bus->available(); }
+
+    /// @brief Get the next byte read.
+    int read() { return _bus->read(); }
+
+};
+
+
+
+
+
+#endif
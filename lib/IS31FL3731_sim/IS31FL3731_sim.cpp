@@ -0,0 +1,332 @@
+// a simulated IS31FL3731, to hang off the simulated wire bus on a linux host.
+#include <IS31FL3731_sim.h>
+
+
+
+
+/// @brief Constructor for the simulated chip.  Starts out as it does after power on.
+/// @param address The i2c address the chip answers on.
+/// @param maxclock The fastest bus clock the chip keeps up with, in hz.  Faster transactions are not acknowledged.
+IS31FL3731Sim::IS31FL3731Sim( uint8_t address , uint32_t maxclock ) {
+
+    _address = address;
+    _maxclock = maxclock;
+
+    reset();
+
+}
+
+
+/// @brief Put every register back the way it is after power on, and the counters back to zero.
+void IS31FL3731Sim::reset() {
+
+    memset( _frame , 0 , sizeof( _frame ) );
+    memset( _control , 0 , sizeof( _control ) );
+
+    _page = 0x00;
+    _pointer = 0x00;
+    _interrupt = 0;
+    _autoplaystart = nativeClockNanosecondsGet();
+    _autoplaydone = 0;
+
+    countReset();
+
+}
+
+
+
+
+/// @brief Write a register in the selected page.  Registers that are not there, or are read only, ignore it.
+/// @param address The register address.
+/// @param data The byte.
+void IS31FL3731Sim::_registerWrite( uint8_t address , uint8_t data ) {
+
+    _registerwrites++;
+
+    // animation frames
+    if ( _page < 8 ) {
+
+        if ( address < IS31FL3731_SIM_FRAME_REGISTER_COUNT ) { _frame[ _page ][ address ] = data; }
+        return;
+
+    }
+
+    // nothing else is there
+    if ( _page != IS31FL3731_SIM_PAGE_CONTROL ) { return; }
+    if ( address >= IS31FL3731_SIM_CONTROL_REGISTER_COUNT ) { return; }
+
+    // the frame state register is read only
+    if ( address == IS31FL3731_SIM_FRAME_STATE_REG ) { return; }
+
+    // auto frame play starts again whenever the mode or its settings change
+    if ( ( address <= 0x03 ) && ( _control[ address ] != data ) ) {
+
+        _autoplaystart = nativeClockNanosecondsGet();
+        _autoplaydone = 0;
+        _interrupt = 0;
+
+    }
+
+    _control[ address ] = data;
+
+}
+
+
+/// @brief Read a register in the selected page, clearing anything that clears on read.
+/// @param address The register address.
+/// @return The byte, 0 for registers that are not there.
+uint8_t IS31FL3731Sim::_registerRead( uint8_t address ) {
+
+    // animation frames
+    if ( _page < 8 ) {
+
+        if ( address < IS31FL3731_SIM_FRAME_REGISTER_COUNT ) { return _frame[ _page ][ address ]; }
+        return 0x00;
+
+    }
+
+    // nothing else is there
+    if ( _page != IS31FL3731_SIM_PAGE_CONTROL ) { return 0x00; }
+    if ( address >= IS31FL3731_SIM_CONTROL_REGISTER_COUNT ) { return 0x00; }
+
+    if ( address != IS31FL3731_SIM_FRAME_STATE_REG ) { return _control[ address ]; }
+
+    // the interrupt clears once it has been seen
+    uint8_t framestate = _frameStateGet();
+    _interrupt = 0;
+
+    return framestate;
+
+}
+
+
+/// @brief Work out the frame state register from the auto frame play settings and the simulated clock.
+/// @return The frame state register, interrupt in bit 4, current frame in bits 0-2.
+uint8_t IS31FL3731Sim::_frameStateGet() {
+
+    uint8_t mode = ( _control[ 0x00 ] >> 3 ) & 0b00000011;
+    uint8_t startframe = _control[ 0x00 ] & 0b00000111;
+    uint8_t currentframe = startframe;
+
+    // picture mode shows whatever the picture display register says
+    if ( mode == 0b00 ) { currentframe = _control[ 0x01 ] & 0b00000111; }
+
+    // auto frame play steps through the frames on its own
+    if ( mode == 0b01 ) {
+
+        uint8_t frames = _control[ 0x02 ] & 0b00000111;
+        if ( !frames ) { frames = 8; }
+
+        uint8_t loops = ( _control[ 0x02 ] >> 4 ) & 0b00000111;
+
+        uint8_t framedelay = _control[ 0x03 ] & 0b00111111;
+        if ( !framedelay ) { framedelay = 64; }
+
+        uint64_t shown = ( nativeClockNanosecondsGet() - _autoplaystart ) / ( (uint64_t)( framedelay ) * IS31FL3731_SIM_FRAME_DELAY_STEP_NS );
+
+        // finished, it stops on the last frame and raises the interrupt
+        if ( loops && ( shown >= (uint64_t)( loops ) * frames ) ) {
+
+            // the interrupt is raised once per run, not every time we look
+            if ( !_autoplaydone ) { _interrupt = 1; }
+            _autoplaydone = 1;
+
+            currentframe = ( startframe + frames - 1 ) & 0b00000111;
+
+        }
+        else {
+
+            currentframe = ( startframe + ( shown % frames ) ) & 0b00000111;
+
+        }
+
+    }
+
+    return (uint8_t)( ( _interrupt << 4 ) | currentframe );
+
+}
+
+
+
+
+/// @brief Sets the i2c address the chip answers on.
+/// @param address The i2c address.
+void IS31FL3731Sim::addressSet( uint8_t address ) {
+
+    _address = address;
+
+}
+
+
+/// @brief Sets the fastest bus clock the chip keeps up with.
+/// @param maxclock The bus clock in hz.
+void IS31FL3731Sim::maxClockSet( uint32_t maxclock ) {
+
+    _maxclock = maxclock;
+
+}
+
+
+/// @brief Gets the fastest bus clock the chip keeps up with.
+/// @return The bus clock in hz.
+uint32_t IS31FL3731Sim::maxClockGet() {
+
+    return _maxclock;
+
+}
+
+
+/// @brief Look at a frame register, without going over the bus.
+/// @param framenumber The frame. 0-7.
+/// @param address The register address. 0x00-0xB3.
+/// @return The byte.
+uint8_t IS31FL3731Sim::frameRegisterGet( uint8_t framenumber , uint8_t address ) {
+
+    return _frame[ framenumber & 0b00000111 ][ address % IS31FL3731_SIM_FRAME_REGISTER_COUNT ];
+
+}
+
+
+/// @brief Change a frame register behind the driver's back, without going over the bus.
+/// @param framenumber The frame. 0-7.
+/// @param address The register address. 0x00-0xB3.
+/// @param data The byte.
+void IS31FL3731Sim::frameRegisterSet( uint8_t framenumber , uint8_t address , uint8_t data ) {
+
+    _frame[ framenumber & 0b00000111 ][ address % IS31FL3731_SIM_FRAME_REGISTER_COUNT ] = data;
+
+}
+
+
+/// @brief Look at a control register, without going over the bus or clearing anything.
+/// @param address The register address. 0x00-0x0C.
+/// @return The byte.
+uint8_t IS31FL3731Sim::controlRegisterGet( uint8_t address ) {
+
+    if ( address >= IS31FL3731_SIM_CONTROL_REGISTER_COUNT ) { return 0x00; }
+
+    if ( address == IS31FL3731_SIM_FRAME_STATE_REG ) { return _frameStateGet(); }
+
+    return _control[ address ];
+
+}
+
+
+/// @brief Gets the selected page.
+/// @return 0-7 for an animation frame, 0x0B for the control page.
+uint8_t IS31FL3731Sim::pageGet() {
+
+    return _page;
+
+}
+
+
+/// @brief Gets the frame the chip is showing right now.
+/// @return The frame number. 0-7.
+uint8_t IS31FL3731Sim::displayedFrameGet() {
+
+    return _frameStateGet() & 0b00000111;
+
+}
+
+
+/// @brief Gets how many times the page has been selected.
+uint32_t IS31FL3731Sim::pageSelectCountGet() {
+
+    return _pageselects;
+
+}
+
+
+/// @brief Gets how many registers have been written, not counting page selects.
+uint32_t IS31FL3731Sim::registerWriteCountGet() {
+
+    return _registerwrites;
+
+}
+
+
+/// @brief Puts the page select and register write counts back to zero.
+void IS31FL3731Sim::countReset() {
+
+    _pageselects = 0;
+    _registerwrites = 0;
+
+}
+
+
+
+
+/// @brief Gets the i2c address the chip answers on.
+uint8_t IS31FL3731Sim::addressGet() {
+
+    return _address;
+
+}
+
+
+/// @brief Take the bytes of a write transaction.
+/// @param data The bytes, after the address byte.
+/// @param count How many bytes.
+/// @param busclock The bus clock in hz.
+/// @return 0 if all were acknowledged, 2 if the bus is too fast for us.
+uint8_t IS31FL3731Sim::receive( const uint8_t *data , uint8_t count , uint32_t busclock ) {
+
+    // too fast, we never even see our address
+    if ( busclock > _maxclock ) { return 2; }
+
+    // an empty write just checks we are here
+    if ( !count ) { return 0; }
+
+    // the first byte is the register address
+    uint8_t address = data[ 0 ];
+
+    // the command register selects the page, from any page
+    if ( address == IS31FL3731_SIM_COMMAND_REG ) {
+
+        if ( count < 2 ) { _pointer = address; return 0; }
+
+        _pageselects++;
+
+        // only frames 0-7 and the control page are there
+        if ( ( data[ 1 ] < 8 ) || ( data[ 1 ] == IS31FL3731_SIM_PAGE_CONTROL ) ) { _page = data[ 1 ]; }
+
+        return 0;
+
+    }
+
+    // the rest auto increment from the register address
+    _pointer = address;
+
+    for ( uint8_t i = 1 ; i < count ; i++ ) {
+
+        _registerWrite( _pointer , data[ i ] );
+        _pointer++;
+
+    }
+
+    return 0;
+
+}
+
+
+/// @brief Send the bytes of a read transaction, carrying on from the address pointer.
+/// @param data Where to put the bytes.
+/// @param count How many bytes the bus asked for.
+/// @param busclock The bus clock in hz.
+/// @return How many bytes were sent, 0 if the bus is too fast for us.
+uint8_t IS31FL3731Sim::request( uint8_t *data , uint8_t count , uint32_t busclock ) {
+
+    // too fast, we never even see our address
+    if ( busclock > _maxclock ) { return 0; }
+
+    for ( uint8_t i = 0 ; i < count ; i++ ) {
+
+        data[ i ] = _registerRead( _pointer );
+        _pointer++;
+
+    }
+
+    return count;
+
+}
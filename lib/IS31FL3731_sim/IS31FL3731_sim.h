@@ -0,0 +1,173 @@
+#ifndef IS31FL3731_SIM_HEADER_GUARD
+#define IS31FL3731_SIM_HEADER_GUARD
+
+
+// a simulated IS31FL3731, to hang off the simulated wire bus on a linux host.
+//
+// models the register file the way the datasheet describes it:
+//   0xFD selects the page, 0-7 for the animation frames, 0x0B for the control page.
+//   writes and reads auto increment, and the address pointer carries on across reads.
+//   the frame state register 0x07 is read only, and its interrupt bit clears when it is read.
+//   auto frame play runs off the simulated clock, so the frame state register moves on as time passes.
+
+// pull in the arduino headers
+#include <Arduino.h>
+
+// pull in the simulated wire library
+#include <Wire.h>
+
+
+// the command register, writing a page number here selects the page
+#define IS31FL3731_SIM_COMMAND_REG 0xFD
+
+// the control page
+#define IS31FL3731_SIM_PAGE_CONTROL 0x0B
+
+// the registers in an animation frame, 0x00-0xB3
+#define IS31FL3731_SIM_FRAME_REGISTER_COUNT 0xB4
+
+// the registers in the control page, 0x00-0x0C
+#define IS31FL3731_SIM_CONTROL_REGISTER_COUNT 0x0D
+
+// the read only frame state register in the control page
+#define IS31FL3731_SIM_FRAME_STATE_REG 0x07
+
+// one frame delay step in auto frame play, in nanoseconds
+#define IS31FL3731_SIM_FRAME_DELAY_STEP_NS 11000000
+
+// the fastest bus clock the chip keeps up with, in hz
+#define IS31FL3731_SIM_DEFAULT_MAX_CLOCK 1000000
+
+
+
+
+/// @brief A simulated IS31FL3731.
+class IS31FL3731Sim : public TwoWireDevice {
+
+
+    private:
+
+    /// @brief The i2c address the chip answers on.
+    uint8_t _address;
+
+    /// @brief The fastest bus clock the chip keeps up with, in hz.
+    uint32_t _maxclock;
+
+    /// @brief The animation frames.
+    uint8_t _frame[ 8 ][ IS31FL3731_SIM_FRAME_REGISTER_COUNT ];
+
+    /// @brief The control page.
+    uint8_t _control[ IS31FL3731_SIM_CONTROL_REGISTER_COUNT ];
+
+    /// @brief The selected page.
+    uint8_t _page;
+
+    /// @brief The address pointer within the page.
+    uint8_t _pointer;
+
+    /// @brief The latched auto frame play interrupt, cleared when the frame state register is read.
+    uint8_t _interrupt;
+
+    /// @brief When auto frame play last started, on the simulated clock in nanoseconds.
+    uint64_t _autoplaystart;
+
+    /// @brief Set once auto frame play has finished and raised its interrupt.
+    uint8_t _autoplaydone;
+
+    /// @brief How many times the page has been selected.
+    uint32_t _pageselects;
+
+    /// @brief How many registers have been written, not counting page selects.
+    uint32_t _registerwrites;
+
+    /// @brief Write a register in the selected page.  Registers that are not there, or are read only, ignore it.
+    /// @param address The register address.
+    /// @param data The byte.
+    void _registerWrite( uint8_t address , uint8_t data );
+
+    /// @brief Read a register in the selected page, clearing anything that clears on read.
+    /// @param address The register address.
+    /// @return The byte, 0 for registers that are not there.
+    uint8_t _registerRead( uint8_t address );
+
+    /// @brief Work out the frame state register from the auto frame play settings and the simulated clock.
+    /// @return The frame state register, interrupt in bit 4, current frame in bits 0-2.
+    uint8_t _frameStateGet();
+
+
+
+    public:
+
+    /// @brief Constructor for the simulated chip.  Starts out as it does after power on.
+    /// @param address The i2c address the chip answers on.
+    /// @param maxclock The fastest bus clock the chip keeps up with, in hz.  Faster transactions are not acknowledged.
+    IS31FL3731Sim( uint8_t address = 0x75 , uint32_t maxclock = IS31FL3731_SIM_DEFAULT_MAX_CLOCK );
+
+
+    /// @brief Put every register back the way it is after power on, and the counters back to zero.
+    void reset();
+
+
+    /// @brief Sets the i2c address the chip answers on.
+    /// @param address The i2c address.
+    void addressSet( uint8_t address );
+
+    /// @brief Sets the fastest bus clock the chip keeps up with.
+    /// @param maxclock The bus clock in hz.
+    void maxClockSet( uint32_t maxclock );
+
+    /// @brief Gets the fastest bus clock the chip keeps up with.
+    /// @return The bus clock in hz.
+    uint32_t maxClockGet();
+
+
+    /// @brief Look at a frame register, without going over the bus.
+    /// @param framenumber The frame. 0-7.
+    /// @param address The register address. 0x00-0xB3.
+    /// @return The byte.
+    uint8_t frameRegisterGet( uint8_t framenumber , uint8_t address );
+
+    /// @brief Change a frame register behind the driver's back, without going over the bus.
+    /// @param framenumber The frame. 0-7.
+    /// @param address The register address. 0x00-0xB3.
+    /// @param data The byte.
+    void frameRegisterSet( uint8_t framenumber , uint8_t address , uint8_t data );
+
+    /// @brief Look at a control register, without going over the bus or clearing anything.
+    /// @param address The register address. 0x00-0x0C.
+    /// @return The byte.
+    uint8_t controlRegisterGet( uint8_t address );
+
+    /// @brief Gets the selected page.
+    /// @return 0-7 for an animation frame, 0x0B for the control page.
+    uint8_t pageGet();
+
+    /// @brief Gets the frame the chip is showing right now.
+    /// @return The frame number. 0-7.
+    uint8_t displayedFrameGet();
+
+
+    /// @brief Gets how many times the page has been selected.
+    uint32_t pageSelectCountGet();
+
+    /// @brief Gets how many registers have been written, not counting page selects.
+    uint32_t registerWriteCountGet();
+
+    /// @brief Puts the page select and register write counts back to zero.
+    void countReset();
+
+
+
+
+    // the simulated bus calls these
+
+    uint8_t addressGet();
+    uint8_t receive( const uint8_t *data , uint8_t count , uint32_t busclock );
+    uint8_t request( uint8_t *data , uint8_t count , uint32_t busclock );
+
+};
+
+
+
+
+#endif
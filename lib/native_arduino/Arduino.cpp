@@ -0,0 +1,121 @@
+// just enough of the arduino core to build the libraries on a linux host.
+#include <Arduino.h>
+
+
+
+
+// the simulated clock, in nanoseconds
+static uint64_t nativeclock = 0;
+
+// the serial port
+NativeSerial Serial;
+
+
+
+
+/// @brief Gets the simulated time since the program started.
+/// @return The time in nanoseconds.
+uint64_t nativeClockNanosecondsGet() {
+
+    return nativeclock;
+
+}
+
+
+/// @brief Moves the simulated clock on.
+/// @param nanoseconds How far to move it.
+void nativeClockAdvance( uint64_t nanoseconds ) {
+
+    nativeclock += nanoseconds;
+
+}
+
+
+/// @brief Puts the simulated clock back to zero.
+void nativeClockReset() {
+
+    nativeclock = 0;
+
+}
+
+
+/// @brief Microseconds since the program started, on the simulated clock.
+unsigned long micros() {
+
+    return (unsigned long)( nativeclock / 1000 );
+
+}
+
+
+/// @brief Milliseconds since the program started, on the simulated clock.
+unsigned long millis() {
+
+    return (unsigned long)( nativeclock / 1000000 );
+
+}
+
+
+/// @brief Moves the simulated clock on, there is nothing to wait for.
+/// @param milliseconds How long to wait.
+void delay( unsigned long milliseconds ) {
+
+    nativeclock += (uint64_t)( milliseconds ) * 1000000;
+
+}
+
+
+/// @brief Moves the simulated clock on, there is nothing to wait for.
+/// @param microseconds How long to wait.
+void delayMicroseconds( unsigned int microseconds ) {
+
+    nativeclock += (uint64_t)( microseconds ) * 1000;
+
+}
+
+
+/// @brief Pins do nothing on the host.
+void pinMode( uint8_t pin , uint8_t mode ) { (void)( pin ); (void)( mode ); }
+
+/// @brief Pins do nothing on the host.
+void digitalWrite( uint8_t pin , uint8_t value ) { (void)( pin ); (void)( value ); }
+
+/// @brief Pins do nothing on the host, they always read high.
+int digitalRead( uint8_t pin ) { (void)( pin ); return HIGH; }
+
+
+
+
+/// @brief Print a signed number in any base.
+size_t NativeSerial::print( long number , int base ) {
+
+    if ( base == DEC ) { return (size_t)( printf( "%ld" , number ) ); }
+
+    // like the arduino core, other bases print the two's complement
+    return print( (unsigned long)( number ) , base );
+
+}
+
+
+/// @brief Print an unsigned number in any base.
+size_t NativeSerial::print( unsigned long number , int base ) {
+
+    if ( base == DEC ) { return (size_t)( printf( "%lu" , number ) ); }
+    if ( base == HEX ) { return (size_t)( printf( "%lX" , number ) ); }
+
+    // anything else, most significant digit first
+    char digits[ 65 ];
+    uint8_t count = 0;
+
+    do {
+
+        uint8_t digit = (uint8_t)( number % (unsigned long)( base ) );
+        digits[ count++ ] = (char)( ( digit < 10 ) ? ( '0' + digit ) : ( 'A' + digit - 10 ) );
+        number /= (unsigned long)( base );
+
+    } while ( number );
+
+    for ( uint8_t i = 0 ; i < count ; i++ ) { putchar( digits[ count - 1 - i ] ); }
+
+    return count;
+
+}
@@ -0,0 +1,111 @@
+#ifndef NATIVE_ARDUINO_HEADER_GUARD
+#define NATIVE_ARDUINO_HEADER_GUARD
+
+
+// just enough of the arduino core to build the libraries on a linux host.
+// only used by the native environment, see library.json.
+//
+// there is no real time here.  micros(), millis() and delay() all run off a simulated clock,
+// which the simulated wire bus moves on by however long each transaction would take on a real bus.
+
+// the usual c headers the arduino core pulls in for us
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+
+// pin levels and modes
+#define LOW 0x0
+#define HIGH 0x1
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+// number bases for print()
+#define DEC 10
+#define HEX 16
+#define BIN 2
+
+// flash is just memory here
+#define PROGMEM
+#define pgm_read_byte( address ) ( *(const uint8_t *)( address ) )
+#define pgm_read_word( address ) ( *(const uint16_t *)( address ) )
+#define F( string ) ( string )
+
+typedef uint8_t byte;
+
+
+
+
+/// @brief Gets the simulated time since the program started.
+/// @return The time in nanoseconds.
+uint64_t nativeClockNanosecondsGet();
+
+/// @brief Moves the simulated clock on.
+/// @param nanoseconds How far to move it.
+void nativeClockAdvance( uint64_t nanoseconds );
+
+/// @brief Puts the simulated clock back to zero.
+void nativeClockReset();
+
+
+/// @brief Microseconds since the program started, on the simulated clock.
+unsigned long micros();
+
+/// @brief Milliseconds since the program started, on the simulated clock.
+unsigned long millis();
+
+/// @brief Moves the simulated clock on, there is nothing to wait for.
+/// @param milliseconds How long to wait.
+void delay( unsigned long milliseconds );
+
+/// @brief Moves the simulated clock on, there is nothing to wait for.
+/// @param microseconds How long to wait.
+void delayMicroseconds( unsigned int microseconds );
+
+
+/// @brief Pins do nothing on the host.
+void pinMode( uint8_t pin , uint8_t mode );
+
+/// @brief Pins do nothing on the host.
+void digitalWrite( uint8_t pin , uint8_t value );
+
+/// @brief Pins do nothing on the host, they always read high.
+int digitalRead( uint8_t pin );
+
+
+
+
+/// @brief Serial port that prints to stdout.
+class NativeSerial {
+
+
+    public:
+
+    /// @brief Nothing to start on the host.
+    void begin( unsigned long baud ) { (void)( baud ); }
+
+    size_t print( const char *text ) { return (size_t)( printf( "%s" , text ) ); }
+    size_t print( char character ) { return (size_t)( printf( "%c" , character ) ); }
+    size_t print( unsigned char number , int base = DEC ) { return print( (unsigned long)( number ) , base ); }
+    size_t print( int number , int base = DEC ) { return print( (long)( number ) , base ); }
+    size_t print( unsigned int number , int base = DEC ) { return print( (unsigned long)( number ) , base ); }
+    size_t print( long number , int base = DEC );
+    size_t print( unsigned long number , int base = DEC );
+    size_t print( double number , int digits = 2 ) { return (size_t)( printf( "%.*f" , digits , number ) ); }
+
+    size_t println() { return print( "\r\n" ); }
+    template< class T > size_t println( T value ) { size_t n = print( value ); return n + println(); }
+    template< class T > size_t println( T value , int format ) { size_t n = print( value , format ); return n + println(); }
+
+};
+
+extern NativeSerial Serial;
+
+
+
+
+#endif
@@ -0,0 +1,282 @@
+// a simulated wire library for the linux host.
+#include <Wire.h>
+
+
+
+
+// the usual bus
+TwoWire Wire;
+
+
+
+
+/// @brief Constructor for the simulated bus.  100khz, no chips attached.
+TwoWire::TwoWire() {
+
+    for ( uint8_t i = 0 ; i < TWOWIRE_DEVICE_MAX ; i++ ) { _devices[ i ] = NULL; }
+
+    _busclock = 100000;
+
+    // a start and a stop take about a bit time each, plus one ack bit per byte.
+    _timing.startbits = 1;
+    _timing.stopbits = 1;
+    _timing.ackbits = 1;
+    _timing.overheadns = 0;
+
+    statsReset();
+
+    _txaddress = 0;
+    _txcount = 0;
+    _txoverflow = 0;
+    _rxcount = 0;
+    _rxindex = 0;
+
+}
+
+
+
+
+/// @brief Finds the chip at an address.
+/// @param address The i2c address.
+/// @return The chip, or NULL if nobody is there.
+TwoWireDevice *TwoWire::_deviceFind( uint8_t address ) {
+
+    for ( uint8_t i = 0 ; i < TWOWIRE_DEVICE_MAX ; i++ ) {
+
+        if ( _devices[ i ] && ( _devices[ i ]->addressGet() == address ) ) { return _devices[ i ]; }
+
+    }
+
+    return NULL;
+
+}
+
+
+/// @brief Moves the clocks on by how long a transaction takes.
+/// @param bytes How many bytes went over the bus, including the address byte.
+void TwoWire::_busTime( uint8_t bytes ) {
+
+    uint32_t bits = _timing.startbits + _timing.stopbits + (uint32_t)( bytes ) * ( 8 + _timing.ackbits );
+
+    _lastnanoseconds = ( (uint64_t)( bits ) * 1000000000 ) / _busclock + _timing.overheadns;
+
+    _stats.transactions++;
+    _stats.nanoseconds += _lastnanoseconds;
+
+    nativeClockAdvance( _lastnanoseconds );
+
+}
+
+
+
+
+/// @brief Hang a chip off the bus.
+/// @param device The chip.
+/// @return 1 if it was attached, 0 if the bus is full.
+uint8_t TwoWire::attach( TwoWireDevice &device ) {
+
+    for ( uint8_t i = 0 ; i < TWOWIRE_DEVICE_MAX ; i++ ) {
+
+        if ( !_devices[ i ] ) { _devices[ i ] = &device; return 1; }
+
+    }
+
+    return 0;
+
+}
+
+
+/// @brief Take a chip off the bus.
+/// @param device The chip.
+void TwoWire::detach( TwoWireDevice &device ) {
+
+    for ( uint8_t i = 0 ; i < TWOWIRE_DEVICE_MAX ; i++ ) {
+
+        if ( _devices[ i ] == &device ) { _devices[ i ] = NULL; }
+
+    }
+
+}
+
+
+/// @brief Sets how long the parts of a transaction take.
+/// @param timing The timing model.
+void TwoWire::timingSet( const TwoWireTiming &timing ) {
+
+    _timing = timing;
+
+}
+
+
+/// @brief Gets how long the parts of a transaction take.
+/// @return The timing model.
+TwoWireTiming TwoWire::timingGet() {
+
+    return _timing;
+
+}
+
+
+/// @brief Gets what has gone over the bus since the last statsReset().
+/// @return The counters.
+TwoWireStats TwoWire::statsGet() {
+
+    return _stats;
+
+}
+
+
+/// @brief Puts the counters back to zero.
+void TwoWire::statsReset() {
+
+    memset( &_stats , 0 , sizeof( _stats ) );
+    _lastnanoseconds = 0;
+
+}
+
+
+/// @brief Gets how long the last transaction took on the simulated bus.
+/// @return The time in nanoseconds.
+uint64_t TwoWire::lastNanosecondsGet() {
+
+    return _lastnanoseconds;
+
+}
+
+
+/// @brief Gets the bus clock.
+/// @return The bus clock in hz.
+uint32_t TwoWire::clockGet() {
+
+    return _busclock;
+
+}
+
+
+
+
+/// @brief Start building a write.
+/// @param address The i2c address of the chip.
+void TwoWire::beginTransmission( uint8_t address ) {
+
+    _txaddress = address;
+    _txcount = 0;
+    _txoverflow = 0;
+
+}
+
+
+/// @brief Queue a byte to write.  Like the avr core, a full buffer drops it.
+/// @param data The byte.
+/// @return 1 if it was queued, 0 if the buffer is full.
+size_t TwoWire::write( uint8_t data ) {
+
+    if ( _txcount >= BUFFER_LENGTH ) {
+
+        _txoverflow = 1;
+        return 0;
+
+    }
+
+    _txbuffer[ _txcount++ ] = data;
+
+    return 1;
+
+}
+
+
+/// @brief Queue some bytes to write.
+/// @param data The bytes.
+/// @param count How many.
+/// @return How many were queued.
+size_t TwoWire::write( const uint8_t *data , size_t count ) {
+
+    size_t queued = 0;
+
+    while ( ( queued < count ) && write( data[ queued ] ) ) { queued++; }
+
+    return queued;
+
+}
+
+
+/// @brief Send the queued write to the chip.
+/// Stricter than the avr core, a write that overflowed the buffer is not sent at all, so driver bugs show up.
+/// @return 0 on success, 1 data too long, 2 address nack, 3 data nack.
+uint8_t TwoWire::endTransmission() {
+
+    if ( _txoverflow ) {
+
+        _stats.nacks++;
+        return 1;
+
+    }
+
+    TwoWireDevice *device = _deviceFind( _txaddress );
+
+    // nobody home, only the address byte goes out
+    if ( !device ) {
+
+        _busTime( 1 );
+        _stats.nacks++;
+        return 2;
+
+    }
+
+    uint8_t status = device->receive( _txbuffer , _txcount , _busclock );
+
+    // an address nack stops after the address byte, a data nack still clocks the lot as far as the master cares.
+    _busTime( ( status == 2 ) ? 1 : ( 1 + _txcount ) );
+
+    if ( status ) { _stats.nacks++; }
+    else { _stats.byteswritten += _txcount; }
+
+    return status;
+
+}
+
+
+
+
+/// @brief Read bytes from a chip.
+/// @param address The i2c address of the chip.
+/// @param count How many bytes to read, no more than the wire buffer.
+/// @return How many bytes came back.
+uint8_t TwoWire::requestFrom( uint8_t address , uint8_t count ) {
+
+    _rxcount = 0;
+    _rxindex = 0;
+
+    if ( count > BUFFER_LENGTH ) { count = BUFFER_LENGTH; }
+
+    TwoWireDevice *device = _deviceFind( address );
+
+    if ( device ) { _rxcount = device->request( _rxbuffer , count , _busclock ); }
+
+    _busTime( 1 + _rxcount );
+
+    if ( _rxcount ) { _stats.bytesread += _rxcount; }
+    else { _stats.nacks++; }
+
+    return _rxcount;
+
+}
+
+
+/// @brief How many bytes are waiting to be read.
+int TwoWire::available() {
+
+    return _rxcount - _rxindex;
+
+}
+
+
+/// @brief Get the next byte read.
+/// @return The byte, or -1 if there are none left.
+int TwoWire::read() {
+
+    if ( _rxindex >= _rxcount ) { return -1; }
+
+    return _rxbuffer[ _rxindex++ ];
+
+}
@@ -0,0 +1,216 @@
+#ifndef NATIVE_WIRE_HEADER_GUARD
+#define NATIVE_WIRE_HEADER_GUARD
+
+
+// a simulated wire library for the linux host.
+//
+// chips hang off the bus as TwoWireDevice objects.  every transaction is handed to the chip at its address,
+// and the simulated clock is moved on by how long it would take on a real bus, worked out from the bus clock
+// and the timing model.  the bus keeps count of what went over it, so tests can see what the drivers cost.
+
+// pull in the arduino headers
+#include <Arduino.h>
+
+
+// the wire buffer, the same as the avr core so the drivers split transactions the same way.
+#ifndef BUFFER_LENGTH
+#define BUFFER_LENGTH 32
+#endif
+
+// the most chips that can hang off one bus
+#define TWOWIRE_DEVICE_MAX 8
+
+
+
+
+/// @brief A chip on the simulated bus.
+class TwoWireDevice {
+
+
+    public:
+
+    virtual ~TwoWireDevice() {}
+
+    /// @brief Gets the i2c address the chip answers on.
+    virtual uint8_t addressGet() = 0;
+
+    /// @brief Take the bytes of a write transaction.
+    /// @param data The bytes, after the address byte.
+    /// @param count How many bytes.
+    /// @param busclock The bus clock in hz, so the chip can refuse to keep up.
+    /// @return 0 if all were acknowledged, 2 for an address nack, 3 for a data nack.
+    virtual uint8_t receive( const uint8_t *data , uint8_t count , uint32_t busclock ) = 0;
+
+    /// @brief Send the bytes of a read transaction.
+    /// @param data Where to put the bytes.
+    /// @param count How many bytes the bus asked for.
+    /// @param busclock The bus clock in hz, so the chip can refuse to keep up.
+    /// @return How many bytes were sent, 0 for an address nack.
+    virtual uint8_t request( uint8_t *data , uint8_t count , uint32_t busclock ) = 0;
+
+};
+
+
+
+
+/// @brief How long the parts of a transaction take, on top of 8 bits per byte.
+struct TwoWireTiming {
+
+    /// @brief A start condition, in bit times.
+    uint16_t startbits;
+
+    /// @brief A stop condition, in bit times.
+    uint16_t stopbits;
+
+    /// @brief The acknowledge after each byte, in bit times.
+    uint16_t ackbits;
+
+    /// @brief A fixed cost per transaction, the wire library and the mcu, in nanoseconds.
+    uint32_t overheadns;
+
+};
+
+
+
+
+/// @brief What has gone over the bus since the last statsReset().
+struct TwoWireStats {
+
+    /// @brief Write and read transactions, including ones that were not acknowledged.
+    uint32_t transactions;
+
+    /// @brief Data bytes written, not counting address bytes.
+    uint32_t byteswritten;
+
+    /// @brief Data bytes read, not counting address bytes.
+    uint32_t bytesread;
+
+    /// @brief Transactions that were not acknowledged, or ran out of wire buffer.
+    uint32_t nacks;
+
+    /// @brief Simulated bus time, in nanoseconds.
+    uint64_t nanoseconds;
+
+};
+
+
+
+
+/// @brief The simulated wire library.
+class TwoWire {
+
+
+    private:
+
+    /// @brief The chips on the bus.
+    TwoWireDevice *_devices[ TWOWIRE_DEVICE_MAX ];
+
+    /// @brief The bus clock in hz.
+    uint32_t _busclock;
+
+    /// @brief How long the parts of a transaction take.
+    TwoWireTiming _timing;
+
+    /// @brief What has gone over the bus.
+    TwoWireStats _stats;
+
+    /// @brief How long the last transaction took, in nanoseconds.
+    uint64_t _lastnanoseconds;
+
+    /// @brief The address of the write being built.
+    uint8_t _txaddress;
+
+    /// @brief The bytes of the write being built.
+    uint8_t _txbuffer[ BUFFER_LENGTH ];
+
+    /// @brief How many bytes are in _txbuffer.
+    uint8_t _txcount;
+
+    /// @brief Set when a write did not fit in the wire buffer.
+    uint8_t _txoverflow;
+
+    /// @brief The bytes of the last read.
+    uint8_t _rxbuffer[ BUFFER_LENGTH ];
+
+    /// @brief How many bytes are in _rxbuffer.
+    uint8_t _rxcount;
+
+    /// @brief The next byte of _rxbuffer to hand out.
+    uint8_t _rxindex;
+
+    /// @brief Finds the chip at an address.
+    /// @param address The i2c address.
+    /// @return The chip, or NULL if nobody is there.
+    TwoWireDevice *_deviceFind( uint8_t address );
+
+    /// @brief Moves the clocks on by how long a transaction takes.
+    /// @param bytes How many bytes went over the bus, including the address byte.
+    void _busTime( uint8_t bytes );
+
+
+
+    public:
+
+    /// @brief Constructor for the simulated bus.  100khz, no chips attached.
+    TwoWire();
+
+
+    /// @brief Hang a chip off the bus.
+    /// @param device The chip.
+    /// @return 1 if it was attached, 0 if the bus is full.
+    uint8_t attach( TwoWireDevice &device );
+
+    /// @brief Take a chip off the bus.
+    /// @param device The chip.
+    void detach( TwoWireDevice &device );
+
+
+    /// @brief Sets how long the parts of a transaction take.
+    /// @param timing The timing model.
+    void timingSet( const TwoWireTiming &timing );
+
+    /// @brief Gets how long the parts of a transaction take.
+    /// @return The timing model.
+    TwoWireTiming timingGet();
+
+    /// @brief Gets what has gone over the bus since the last statsReset().
+    /// @return The counters.
+    TwoWireStats statsGet();
+
+    /// @brief Puts the counters back to zero.
+    void statsReset();
+
+    /// @brief Gets how long the last transaction took on the simulated bus.
+    /// @return The time in nanoseconds.
+    uint64_t lastNanosecondsGet();
+
+    /// @brief Gets the bus clock.
+    /// @return The bus clock in hz.
+    uint32_t clockGet();
+
+
+
+
+    // the wire library
+
+    void begin() {}
+    void end() {}
+    void setClock( uint32_t busclock ) { _busclock = busclock; }
+
+    void beginTransmission( uint8_t address );
+    size_t write( uint8_t data );
+    size_t write( const uint8_t *data , size_t count );
+    uint8_t endTransmission();
+
+    uint8_t requestFrom( uint8_t address , uint8_t count );
+    int available();
+    int read();
+
+};
+
+extern TwoWire Wire;
+
+
+
+
+#endif
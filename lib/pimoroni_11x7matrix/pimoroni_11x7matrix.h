@@ -15,6 +15,47 @@
 #define wire Wire
 #endif
 
+// pull in the bus transports
+#include <pimoroni_11x7matrix_transport.h>
+
+
+// the number of bytes the wire library can send in one transaction, including the register address.
+// worked out from the core's wire library, define it yourself to override.
+#ifndef PIMORONI_11X7MATRIX_WIRE_BUFFER_SIZE
+    #if defined( I2C_BUFFER_LENGTH )
+        // esp32 and esp8266 cores
+        #define PIMORONI_11X7MATRIX_WIRE_BUFFER_SIZE I2C_BUFFER_LENGTH
+    #elif defined( WIRE_BUFFER_SIZE )
+        // rp2040 core
+        #define PIMORONI_11X7MATRIX_WIRE_BUFFER_SIZE WIRE_BUFFER_SIZE
+    #elif defined( BUFFER_LENGTH )
+        // avr, megaavr and the cores that copied them
+        #define PIMORONI_11X7MATRIX_WIRE_BUFFER_SIZE BUFFER_LENGTH
+    #else
+        // play it safe
+        #define PIMORONI_11X7MATRIX_WIRE_BUFFER_SIZE 32
+    #endif
+#endif
+
+// what starting a new transaction costs, counted in data bytes.
+// start, address byte, register byte and stop come to a little over 2 bytes of bus time, plus the library overhead.
+// gaps shorter than this are padded over instead of starting a new transaction.
+#ifndef PIMORONI_11X7MATRIX_TRANSACTION_OVERHEAD_BYTES
+#define PIMORONI_11X7MATRIX_TRANSACTION_OVERHEAD_BYTES 3
+#endif
+
+// packed pwm mode, compiled out unless PIMORONI_11X7MATRIX_PACKED_PWM is defined.
+// each pixel keeps 4 bits of brightness instead of 8, so the pwm buffer is 39 bytes instead of 88.
+// pixelpwmSet() rounds to the nearest of the 16 levels in pimoroni_11x7matrixPwmLevels, pixelpwmGet() gives the level back,
+// and the levels are looked up as the frame goes out.  like the instrumentation, define it in build_flags.
+
+// the 16 pwm levels of packed mode, spaced for the eye rather than evenly.  in pimoroni_11x7matrix.cpp.
+extern const uint8_t pimoroni_11x7matrixPwmLevels[ 16 ] PROGMEM;
+
+// the gamma curve gammaEnableSet() puts the pwm values through on the way out.  in pimoroni_11x7matrix.cpp.
+extern const uint8_t pimoroni_11x7matrixGamma[ 256 ] PROGMEM;
+
+
 
 
 
@@ -23,6 +64,52 @@
 // the animation page that refers to the control register
 #define IS31FL3731_PAGE_CONTROL 0x0B
 
+// the register blocks in an animation frame page
+#define IS31FL3731_ADDRESS_LED_CONTROL_REG 0x00
+#define IS31FL3731_ADDRESS_BLINK_CONTROL_REG 0x12
+#define IS31FL3731_ADDRESS_PWM_REG 0x24
+
+// the last register in a frame this board uses, the 7th pwm register of the last column.
+#define PIMORONI_11X7MATRIX_FRAME_LAST_REG 0x7A
+
+// status codes.  1-4 come straight from endTransmission().
+#define PIMORONI_11X7MATRIX_OK 0
+#define PIMORONI_11X7MATRIX_ERROR_DATA_TOO_LONG 1
+#define PIMORONI_11X7MATRIX_ERROR_ADDRESS_NACK 2
+#define PIMORONI_11X7MATRIX_ERROR_DATA_NACK 3
+#define PIMORONI_11X7MATRIX_ERROR_OTHER 4
+#define PIMORONI_11X7MATRIX_ERROR_TIMEOUT 5
+#define PIMORONI_11X7MATRIX_ERROR_BUS_STUCK 6
+#define PIMORONI_11X7MATRIX_ERROR_VERIFY 7
+#define PIMORONI_11X7MATRIX_ERROR_BUSY 8
+
+// how long a read waits for the chip by default, in microseconds.
+#ifndef PIMORONI_11X7MATRIX_DEFAULT_TIMEOUT_US
+#define PIMORONI_11X7MATRIX_DEFAULT_TIMEOUT_US 1000
+#endif
+
+// the bus clock begin() tries first, in hz.  it steps down to 400khz then 100khz if the chip can't keep up.
+#ifndef PIMORONI_11X7MATRIX_DEFAULT_BUS_CLOCK
+#define PIMORONI_11X7MATRIX_DEFAULT_BUS_CLOCK 400000
+#endif
+
+// a register begin() can scribble on to test the bus, the unconnected 8th pwm register of the first column in frame 0.
+#define PIMORONI_11X7MATRIX_SCRATCH_REG 0x2B
+
+// which pixel buffers a frame write covers
+#define PIMORONI_11X7MATRIX_BUFFER_STATE 0b00000001
+#define PIMORONI_11X7MATRIX_BUFFER_BLINK 0b00000010
+#define PIMORONI_11X7MATRIX_BUFFER_PWM 0b00000100
+
+// display orientations, a rotation clockwise or'd with any flips.  the flips are done first.
+// a single board can only turn 180, a canvas can turn 90 and 270 as well.
+#define PIMORONI_11X7MATRIX_ROTATE_0 0b00000000
+#define PIMORONI_11X7MATRIX_ROTATE_90 0b00000001
+#define PIMORONI_11X7MATRIX_ROTATE_180 0b00000010
+#define PIMORONI_11X7MATRIX_ROTATE_270 0b00000011
+#define PIMORONI_11X7MATRIX_FLIP_X 0b00000100
+#define PIMORONI_11X7MATRIX_FLIP_Y 0b00001000
+
 // the control register addresses
 #define IS31FL3731_ADDRESS_CONFIG_REG 0x00
 #define IS31FL3731_ADDRESS_PICTURE_DISPLAY_REG 0x01
@@ -37,59 +124,391 @@
 #define IS31FL3731_ADDRESS_AGC_CONTROL_REG 0x0B
 #define IS31FL3731_ADDRESS_AUDIO_ADC_RATE_REG 0x0C
 
+// the number of registers in the control page, 0x00-0x0C
+#define IS31FL3731_CONTROL_REGISTER_COUNT 0x0D
+
+
+// bus traffic instrumentation, compiled out unless PIMORONI_11X7MATRIX_INSTRUMENTATION is defined.
+// it changes the size of the driver, so define it in build_flags where every file sees it, not in a sketch.
+// each public call below counts its own bus traffic and time, calls made from inside it count towards it.
+#define PIMORONI_11X7MATRIX_API_BEGIN 0
+#define PIMORONI_11X7MATRIX_API_RESUME 1
+#define PIMORONI_11X7MATRIX_API_BUS_RECOVER 2
+#define PIMORONI_11X7MATRIX_API_WRITE_ALL 3
+#define PIMORONI_11X7MATRIX_API_WRITE_STATE 4
+#define PIMORONI_11X7MATRIX_API_WRITE_BLINK 5
+#define PIMORONI_11X7MATRIX_API_WRITE_PWM 6
+#define PIMORONI_11X7MATRIX_API_FRAME_READ 7
+#define PIMORONI_11X7MATRIX_API_FRAME_VERIFY 8
+#define PIMORONI_11X7MATRIX_API_CONTROL_READ 9
+#define PIMORONI_11X7MATRIX_API_COMMIT 10
+#define PIMORONI_11X7MATRIX_API_CONTROL_SET 11
+#define PIMORONI_11X7MATRIX_API_FRAME_STATE_GET 12
+#define PIMORONI_11X7MATRIX_API_PUSHER 13
+#define PIMORONI_11X7MATRIX_API_PRESENT 14
+#define PIMORONI_11X7MATRIX_API_DOUBLE_BUFFER 15
+#define PIMORONI_11X7MATRIX_API_OTHER 16
+
+// the number of instrumented calls, including PIMORONI_11X7MATRIX_API_OTHER for anything outside them.
+#define PIMORONI_11X7MATRIX_API_COUNT 17
+
+#if defined( PIMORONI_11X7MATRIX_INSTRUMENTATION )
+    // count a public call, and bus traffic towards whichever call is running.
+    #define PIMORONI_11X7MATRIX_INSTRUMENT( api ) _InstrumentationScope instrumentationscope( this , api )
+    #define PIMORONI_11X7MATRIX_COUNT( field , amount ) ( _instrumentation[ _instrumentationapi ].field += ( amount ) )
+#else
+    #define PIMORONI_11X7MATRIX_INSTRUMENT( api )
+    #define PIMORONI_11X7MATRIX_COUNT( field , amount )
+#endif
+
+
+
+
+
+
+
+/// @brief The columns of a frame that still need sending, one bit per chip index.
+struct Pimoroni_11x7matrixFrameMask {
+
+    /// @brief Columns of led on/off state.
+    uint16_t state;
+
+    /// @brief Columns of led blink state.
+    uint16_t blink;
+
+    /// @brief Columns of pwm values.
+    uint16_t pwm;
+
+};
+
+
+
+
+/// @brief A frame read back from the chip, laid out like the pixel buffers.  x across, y up.
+struct Pimoroni_11x7matrixFrameBuffer {
+
+    /// @brief led on/off state, one byte per column, bit 0 at the bottom.
+    uint8_t state[11];
+
+    /// @brief led blink state, one byte per column, bit 0 at the bottom.
+    uint8_t blink[11];
+
+    /// @brief pwm values, [ x ][ y ].
+    uint8_t pwm[11][7];
+
+};
+
+
+
+
+
+/// @brief Bus traffic and time counted for one instrumented call.
+struct Pimoroni_11x7matrixInstrumentation {
+
+    /// @brief How many times it was called.
+    uint32_t calls;
+
+    /// @brief Time spent in it, in micros().
+    uint32_t micros;
+
+    /// @brief Write and read transactions.
+    uint32_t transactions;
+
+    /// @brief Bytes written, register addresses included.
+    uint32_t byteswritten;
 
+    /// @brief Bytes read.
+    uint32_t bytesread;
 
+    /// @brief Page selects sent.
+    uint32_t pageswitches;
 
+    /// @brief Page selects _switchFrame() saved, because the page was already selected.
+    uint32_t pageswitchesavoided;
 
+    /// @brief Transactions the chip did not acknowledge.
+    uint32_t nacks;
 
+};
+
+
+
+
+/// @brief Driver for the 11x7 matrix board, over any bus transport.
+/// See pimoroni_11x7matrix_transport.h for what a transport needs.  Use Pimoroni_11x7matrix for the usual Wire bus.
+template< class Transport >
+class Pimoroni_11x7matrixT {
+
+    // the background frame pusher streams straight from our internals.
+    template< class > friend class Pimoroni_11x7matrixPusherT;
 
-class Pimoroni_11x7matrix {
+    // and the tiled canvas interleaves our uploads with other boards'.
+    template< class > friend class Pimoroni_11x7matrixCanvasT;
+
+    // and the frame pool hashes the frame image.
+    template< class > friend class Pimoroni_11x7matrixFramePoolT;
+
+    // and the drawing primitives work a column at a time on the pixel buffers.
+    template< class > friend class Pimoroni_11x7matrixDrawT;
+
+    // and text blits glyph columns the same way.
+    template< class > friend class Pimoroni_11x7matrixTextT;
 
 
     private:
 
-    /// @brief The pixel buffer for the on/off state.
+    /// @brief The bus to talk to the chip over.
+    Transport _transport;
+
+    // the pixel buffers are laid out the way the chip's registers are, one column per chip index,
+    // so uploads copy straight out of them.  pixelSet() and friends look up the chip index for x.
+
+    /// @brief The pixel buffer for the on/off state, by chip index.  Registers 0x00-0x0A as they are.
     uint8_t _ledstate[11];
 
-    /// @brief The pixel buffer for the blink on/off state.
+    /// @brief The pixel buffer for the blink on/off state, by chip index.  Registers 0x12-0x1C as they are.
     uint8_t _ledblinkstate[11];
 
-    /// @brief The pixel buffer for the pwm values.
-    uint8_t _ledpwmstate[11][7];
+    #if defined( PIMORONI_11X7MATRIX_PACKED_PWM )
+
+    /// @brief The pixel buffer for the pwm levels, two pixels a byte, low nibble first.
+    /// Pixel chipindex * 7 + y, each an index into pimoroni_11x7matrixPwmLevels.
+    uint8_t _ledpwmstate[ 39 ];
+
+    /// @brief Finds the nearest packed mode level to a pwm value.
+    /// @param data The pwm value.
+    /// @return The level. 0-15.
+    static uint8_t _pwmLevelFind( uint8_t data );
+
+    #else
+
+    /// @brief The pixel buffer for the pwm values, [ chip index ][ y ].  Registers 0x24-0x7A as they are.
+    /// The 8th register of each column is not connected on this board, and is always zero.
+    uint8_t _ledpwmstate[11][8];
+
+    #endif
+
+    /// @brief Dirty flags for _ledstate.  One byte per chip index, one bit per frame that has not been sent the column yet.
+    uint8_t _ledstatedirty[11];
+
+    /// @brief Dirty flags for _ledblinkstate.  One byte per chip index, one bit per frame that has not been sent the column yet.
+    uint8_t _ledblinkstatedirty[11];
+
+    /// @brief Dirty flags for _ledpwmstate.  One byte per chip index, one bit per frame that has not been sent the column yet.
+    uint8_t _ledpwmstatedirty[11];
+
+    /// @brief The chip index of each x position, the chip interleaves the columns as 0,6,1,7,2,8,3,9,4,10,5.
+    static constexpr uint8_t _columnToChipIndex[ 11 ] = { 0 , 2 , 4 , 6 , 8 , 10 , 1 , 3 , 5 , 7 , 9 };
+
+    /// @brief The chip index of each x position the pixel functions are given, the right way round and mirrored.
+    static constexpr uint8_t _orientColumn[ 2 ][ 11 ] = { { 0 , 2 , 4 , 6 , 8 , 10 , 1 , 3 , 5 , 7 , 9 } , { 9 , 7 , 5 , 3 , 1 , 10 , 8 , 6 , 4 , 2 , 0 } };
+
+    /// @brief The row of each y position the pixel functions are given, the right way up and upside down.
+    static constexpr uint8_t _orientRow[ 2 ][ 7 ] = { { 0 , 1 , 2 , 3 , 4 , 5 , 6 } , { 6 , 5 , 4 , 3 , 2 , 1 , 0 } };
+
+    /// @brief The row of _orientColumn in use.
+    const uint8_t *_columnmap;
+
+    /// @brief The row of _orientRow in use.
+    const uint8_t *_rowmap;
+
+    /// @brief The orientation set by orientationSet().
+    uint8_t _orientation;
+
+    /// @brief Turns a column mask the way up orientationSet() says.
+    /// @param mask The mask, bit 0 at the bottom as the caller sees it.
+    /// @return The mask, bit 0 at the bottom of the chip's column.
+    uint8_t _columnMaskOrient( uint8_t mask );
 
     /// @brief The i2c address of the chip.
     uint8_t _i2c_address;
 
 
+    /// @brief How long a read may wait for the chip, in microseconds.
+    uint32_t _timeout;
+
+    /// @brief The result of the last bus transaction.
+    uint8_t _laststatus;
+
+    /// @brief The bus clock we settled on, in hz.
+    uint32_t _busclock;
+
+    /// @brief Start the wire library and find the fastest bus clock that works, up to the one asked for.
+    /// @param new_i2c_address The i2c address of the chip.
+    /// @param busclock The bus clock to try first, in hz.
+    /// @return PIMORONI_11X7MATRIX_OK, or the error from the slowest clock tried.
+    uint8_t _busStart( uint8_t new_i2c_address , uint32_t busclock );
+
+    /// @brief Set the bus clock, and check a write and read back work at that speed.
+    /// @param busclock The bus clock in hz.
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t _busClockTry( uint32_t busclock );
+
+    /// @brief Finish a write transaction, remembering how it went.
+    /// @return The result from wire.endTransmission(). 0 is PIMORONI_11X7MATRIX_OK.
+    uint8_t _busEndTransmission();
+
+    /// @brief Queue a byte to write, counting it.
+    /// @param data The byte.
+    void _busWrite( uint8_t data );
+
+    /// @brief Queue several bytes to write, counting them.
+    /// @param data The bytes.
+    /// @param count How many bytes.
+    void _busWrite( const uint8_t *data , uint8_t count );
+
+    /// @brief Read bytes back from the chip, from wherever its address pointer is.  Never waits longer than the timeout.
+    /// @param data Where to put the bytes.
+    /// @param count How many bytes to read.  No more than the wire buffer size.
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t _busRead( uint8_t *data , uint8_t count );
+
     /// @brief Write a single byte of data to the chip.
     /// @param framenumber The number of the frame to write to. 0x00-0x07 Animation. 0x0B Control.
     /// @param address The address within the frame to write to.
     /// @param data The data byte to write to the chip.
-    void _chipwritebyte( uint8_t framenumber , uint8_t address , uint8_t data );
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t _chipwritebyte( uint8_t framenumber , uint8_t address , uint8_t data );
 
     /// @brief Read a single byte of data from the chip.
     /// @param framenumber The number of the frame to read from. 0x00-0x07 Animation. 0x0B Control.
     /// @param address The address within the frame to read from.
-    /// @return The data byte rturned from the chip as a uint8_t.
-    uint8_t _chipreadbyte( uint8_t framenumber , uint8_t address );
+    /// @param data Where to put the byte returned from the chip.
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t _chipreadbyte( uint8_t framenumber , uint8_t address , uint8_t *data );
     
+
+
+    /// @brief RAM shadow copy of the control page registers 0x00-0x0C.  Filled in begin().
+    uint8_t _controlregister[ IS31FL3731_CONTROL_REGISTER_COUNT ];
+
+    /// @brief Write a control register, keeping the shadow copy up to date.
+    /// If the write fails the register is marked changed, so the next commit() sends it again.
+    /// @param address The address within the control page to write to. 0x00-0x0C.
+    /// @param data The data byte to write to the chip.
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t _controlRegisterWrite( uint8_t address , uint8_t data );
+
+    /// @brief Point the display at a frame straight away, even inside beginUpdate().
+    /// Double buffering relies on the chip showing the front frame, so this never waits for commit().
+    /// If the write fails the shadow copy is left as it was, and nothing is resent later.
+    /// @param framenumber The frame to show. 0-7.
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t _displayFrameWrite( uint8_t framenumber );
+
+    /// @brief Fill the control register shadow copy from the chip.
+    /// The frame state register 0x07 is skipped, reading it would clear the frame interrupt.
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t _controlRegisterCacheLoad();
+
+
+    /// @brief How many beginUpdate() calls are waiting for a commit().
+    uint8_t _controlupdatedepth;
+
+    /// @brief One bit per control register changed since beginUpdate(), bit 0 = 0x00.
+    uint16_t _controlregisterdirty;
     
     
 
 
     /// @brief Optimised write to chip.
     /// @param framenumber The frame number to write to.
-    void _pixelBufferStateFastWrite( uint8_t framenumber );
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t _pixelBufferStateFastWrite( uint8_t framenumber );
 
 
     /// @brief Optimised write to chip.
     /// @param framenumber The frame number to write to.
-    void _pixelBufferBlinkStateFastWrite( uint8_t framenumber );
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t _pixelBufferBlinkStateFastWrite( uint8_t framenumber );
 
 
     /// @brief Optimised write to chip.
     /// @param  framenumber The frame number to write to.
-    void _pixelBufferpwmStateFastWrite( uint8_t framenumber );
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t _pixelBufferpwmStateFastWrite( uint8_t framenumber );
+
+
+    /// @brief Store a new column byte in a bit buffer, marking it dirty if it changed.
+    /// @param buffer The bit buffer to store into, _ledstate or _ledblinkstate.
+    /// @param dirty The dirty flags belonging to the buffer.
+    /// @param chipindex The chip index of the column. 0-10.
+    /// @param data The new column byte.
+    void _bitBufferColumnSet( uint8_t *buffer , uint8_t *dirty , uint8_t chipindex , uint8_t data );
+
+    /// @brief Store a new pwm value, marking its column dirty if it changed.
+    /// @param chipindex The chip index of the pixel's column. 0-10.
+    /// @param ypos The y position of the pixel.
+    /// @param data The new pwm value.
+    void _pwmBufferSet( uint8_t chipindex , uint8_t ypos , uint8_t data );
+
+    /// @brief Gets a pwm value from the pixel buffer.
+    /// @param chipindex The chip index of the pixel's column. 0-10.
+    /// @param ypos The y position of the pixel.
+    /// @return The pwm value.
+    uint8_t _pwmBufferGet( uint8_t chipindex , uint8_t ypos );
+
+    /// @brief Finds where a register of the frame image is kept in the pixel buffers.
+    /// @param address The register address within the frame. 0x00-0x7A.
+    /// @param count Set to how many registers from there on are kept straight after it, or have to be worked out along with it.  Never past 0x7A.
+    /// @return The buffer byte holding the register, or NULL if it has to be worked out a byte at a time by _frameImageByte().
+    const uint8_t *_frameImageSpan( uint8_t address , uint8_t *count );
+
+    /// @brief Gets the byte the chip should hold at a register in a frame, built from the pixel buffers.
+    /// @param address The register address within the frame. 0x00-0x7A.
+    /// @return The register byte.  Registers this board does not use are zero.
+    uint8_t _frameImageByte( uint8_t address );
+
+    /// @brief Checks if a register belongs to a column that needs sending.
+    /// @param address The register address within the frame. 0x00-0x7A.
+    /// @param mask The columns that need sending.
+    /// @return 1 if the register needs sending, 0 if not.
+    static uint8_t _frameImageWanted( uint8_t address , const Pimoroni_11x7matrixFrameMask *mask );
+
+    /// @brief Collects the dirty columns of a frame into a mask, and marks them as sent.
+    /// @param framenumber The frame number that is about to be written. 0-7.
+    /// @param buffers Which buffers to collect, PIMORONI_11X7MATRIX_BUFFER_STATE, _BLINK and _PWM or'd together.
+    /// @param mask Where to put the columns that need sending.
+    void _frameImageDirtyTake( uint8_t framenumber , uint8_t buffers , Pimoroni_11x7matrixFrameMask *mask );
+
+    /// @brief Sends the next run of wanted registers as one transaction, filled up to the wire buffer size.
+    /// Registers 0x00-0x7A are one auto increment space.  Gaps shorter than PIMORONI_11X7MATRIX_TRANSACTION_OVERHEAD_BYTES
+    /// are padded over, longer ones end the transaction.
+    /// @param framenumber The frame number to write to. 0-7.
+    /// @param address The register to start looking from.  Moved on past whatever was sent, past 0x7A when there is nothing left.
+    /// @param mask The columns that need sending.
+    /// @param image A copy of the frame image to send from, or NULL to send from the pixel buffers.
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t _frameImageRunWrite( uint8_t framenumber , uint8_t *address , const Pimoroni_11x7matrixFrameMask *mask , const uint8_t *image );
+
+    /// @brief Send the dirty parts of the pixel buffers to a frame, in as few transactions as possible.
+    /// @param framenumber The frame number to write to. 0-7.
+    /// @param buffers Which buffers to send, PIMORONI_11X7MATRIX_BUFFER_STATE, _BLINK and _PWM or'd together.
+    /// @return PIMORONI_11X7MATRIX_OK, PIMORONI_11X7MATRIX_ERROR_BUSY if a pusher is still streaming to the frame, or an error code.
+    uint8_t _frameImageWrite( uint8_t framenumber , uint8_t buffers );
+
+    /// @brief Store a register byte read back from the chip into a frame buffer, undoing the column interleave.
+    /// @param address The register address within the frame. 0x00-0x7A.
+    /// @param data The register byte.
+    /// @param buffer The frame buffer to store into.  Registers this board does not use are ignored.
+    static void _frameImageDecode( uint8_t address , uint8_t data , Pimoroni_11x7matrixFrameBuffer *buffer );
+
+    /// @brief Read registers 0x00-0x7A of a frame back from the chip.
+    /// One address write, then sequential reads of up to a wire buffer each, the chip auto increments across them.
+    /// @param framenumber The frame number to read. 0-7.
+    /// @param buffer Where to put the frame.
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t _frameImageRead( uint8_t framenumber , Pimoroni_11x7matrixFrameBuffer *buffer );
+
+    /// @brief Hands columns that could not be sent back to the dirty flags, so the next write tries again.
+    /// @param framenumber The frame number the columns were meant for. 0-7.
+    /// @param mask The columns that did not make it.
+    void _frameImageDirtyReturn( uint8_t framenumber , const Pimoroni_11x7matrixFrameMask *mask );
+
+    /// @brief The chip interleaves the columns as 0,6,1,7,2,8,3,9,4,10,5.  Turn a chip column index into an x position.
+    /// @param chipindex The column index in chip register order. 0-10.
+    /// @return The x position of that column. 0-10.
+    static uint8_t _chipIndexToColumn( uint8_t chipindex ) { return ( chipindex >> 1 ) + ( ( chipindex & 0b00000001 ) ? 6 : 0 ); }
 
 
 
@@ -97,9 +516,110 @@ class Pimoroni_11x7matrix {
     /// @brief The last frame number we switched to.  0-7, 0b for control page.
     uint8_t _currentframe;
 
+    /// @brief The frame a pusher is streaming to, 0xFF if none.  Blocking writes to it are refused until it is done.
+    uint8_t _pushframe;
+
     /// @brief Switch to a different frame, if necessary.
     /// @param framenumber The frame number to switch to.
-    void _switchFrame( uint8_t framenumber );
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t _switchFrame( uint8_t framenumber );
+
+
+
+
+    /// @brief 1 while double buffering, between doubleBufferBegin() and doubleBufferEnd().
+    uint8_t _doublebuffered;
+
+    /// @brief The frame on display while double buffering. 0-7.
+    uint8_t _frontframe;
+
+    /// @brief The frame present() uploads to while double buffering. 0-7.
+    uint8_t _backframe;
+
+
+
+
+    /// @brief 1 in brightness only mode, between brightnessOnlyBegin() and brightnessOnlyEnd().
+    uint8_t _brightnessonly;
+
+    /// @brief Sets a pixel on or off in brightness only mode, by its pwm value.
+    /// @param chipindex The chip index of the pixel's column. 0-10.
+    /// @param ypos The y position of the pixel.
+    /// @param state 0 for off, anything else for on.
+    void _brightnessPixelSet( uint8_t chipindex , uint8_t ypos , uint8_t state );
+
+    /// @brief Folds the state buffer into the pwm buffer, zeroing the pwm of every pixel that is off, then turns every state bit on.
+    void _brightnessOnlyFold();
+
+    /// @brief Gets a column of on/off states, from the pwm values in brightness only mode.
+    /// @param chipindex The chip index of the column. 0-10.
+    /// @return The column, bit 0 at the bottom of the chip.
+    uint8_t _stateColumnGet( uint8_t chipindex );
+
+    /// @brief Stores a column of on/off states, through the pwm values in brightness only mode.
+    /// @param chipindex The chip index of the column. 0-10.
+    /// @param data The column, bit 0 at the bottom of the chip.
+    void _stateColumnSet( uint8_t chipindex , uint8_t data );
+
+
+
+
+    /// @brief 1 if pwm values go through pimoroni_11x7matrixGamma on the way out.
+    uint8_t _gamma;
+
+    /// @brief The master brightness every pwm value is scaled by on the way out.  255 is as stored.
+    uint8_t _masterbrightness;
+
+    /// @brief Gets what the chip is sent for a pwm value, after the master brightness and gamma.
+    /// @param data The pwm value as stored.
+    /// @return The pwm value to send.
+    uint8_t _pwmOutput( uint8_t data );
+
+
+
+
+    #if defined( PIMORONI_11X7MATRIX_INSTRUMENTATION )
+
+    /// @brief Bus traffic and time counted for each instrumented call.
+    Pimoroni_11x7matrixInstrumentation _instrumentation[ PIMORONI_11X7MATRIX_API_COUNT ];
+
+    /// @brief The instrumented call running now, PIMORONI_11X7MATRIX_API_OTHER if none.
+    uint8_t _instrumentationapi;
+
+    /// @brief Counts the outermost instrumented call it is made in, for as long as it is in scope.
+    class _InstrumentationScope {
+
+        Pimoroni_11x7matrixT *_matrix;
+        uint8_t _owner;
+        uint32_t _starttime;
+
+        public:
+
+        _InstrumentationScope( Pimoroni_11x7matrixT *matrix , uint8_t api ) : _matrix( matrix ) , _owner( 0 ) {
+
+            // calls made from inside another call count towards that one
+            if ( _matrix->_instrumentationapi != PIMORONI_11X7MATRIX_API_OTHER ) { return; }
+
+            _owner = 1;
+            _matrix->_instrumentationapi = api;
+            _starttime = micros();
+
+        }
+
+        ~_InstrumentationScope() {
+
+            if ( !_owner ) { return; }
+
+            _matrix->_instrumentation[ _matrix->_instrumentationapi ].calls++;
+            _matrix->_instrumentation[ _matrix->_instrumentationapi ].micros += micros() - _starttime;
+            _matrix->_instrumentationapi = PIMORONI_11X7MATRIX_API_OTHER;
+
+        }
+
+    };
+
+    #endif
+
 
 
 
@@ -114,12 +634,64 @@ class Pimoroni_11x7matrix {
     public:
 
     /// @brief Constructor for Pimoroni 11x7 Matrix Driver
-    Pimoroni_11x7matrix();
+    /// @param transport The bus to talk to the chip over.
+    Pimoroni_11x7matrixT( const Transport &transport = Transport() );
 
 
     /// @brief Set the i2c address and perform any setup required.
+    /// The bus clock is checked with a write and read back, and stepped down to 400khz then 100khz until that works.
     /// @param new_i2c_address The i2c address of the chip.
-    void begin( uint8_t new_i2c_address );
+    /// @param busclock The bus clock to try first, in hz.
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t begin( uint8_t new_i2c_address = 0x75 , uint32_t busclock = PIMORONI_11X7MATRIX_DEFAULT_BUS_CLOCK );
+
+    /// @brief Take over a chip that is already running, without clearing the display.
+    /// Use this after the mcu resets.  The control registers and the displayed frame are read back
+    /// into the shadow copy and pixel buffers, the other frames are left for the next writes.
+    /// @param new_i2c_address The i2c address of the chip.
+    /// @param busclock The bus clock to try first, in hz.  Checked the same way as begin().
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t resume( uint8_t new_i2c_address = 0x75 , uint32_t busclock = PIMORONI_11X7MATRIX_DEFAULT_BUS_CLOCK );
+
+
+
+
+    /// @brief Sets how long a read may wait for the chip before giving up.
+    /// Where the core supports it, writes are given the same timeout.
+    /// @param microseconds The timeout in microseconds.
+    void timeoutSet( uint32_t microseconds );
+
+    /// @brief Gets how long a read may wait for the chip before giving up.
+    /// @return The timeout in microseconds.
+    uint32_t timeoutGet();
+
+    /// @brief Gets the bus clock begin() settled on.
+    /// @return The bus clock in hz.
+    uint32_t busClockGet();
+
+    /// @brief Gets the result of the last bus transaction.
+    /// Getters that have to read the chip return 0 on failure, this tells you why.
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t lastStatusGet();
+
+    /// @brief Try to free a stuck bus, then restart the bus.
+    /// The wire transport clocks SCL until whoever holds SDA low lets go, sends a stop, then restarts the wire library.
+    /// @return PIMORONI_11X7MATRIX_OK, or PIMORONI_11X7MATRIX_ERROR_BUS_STUCK if the bus is still held low.
+    uint8_t busRecover();
+
+
+
+    /// @brief Gets the bus traffic and time counted for one call since the last instrumentationReset().
+    /// Everything is zero unless PIMORONI_11X7MATRIX_INSTRUMENTATION is defined.
+    /// @param api The call, PIMORONI_11X7MATRIX_API_BEGIN and so on.
+    /// @param counters Where to put the counts.
+    void instrumentationGet( uint8_t api , Pimoroni_11x7matrixInstrumentation *counters );
+
+    /// @brief Puts all the instrumentation counts back to zero.
+    void instrumentationReset();
+
+    /// @brief Prints the instrumentation counts over Serial, one line per call that did anything.
+    void instrumentationDump();
 
 
 
@@ -132,30 +704,144 @@ class Pimoroni_11x7matrix {
 
 
     /// @brief Write the pixel buffer to a frame on the chip.
+    /// State, blink and pwm go out together, each transaction filled to the wire buffer size.
+    /// A whole frame costs 5 transactions with the 32 byte avr buffer, 3 with a buffer of 88 bytes or more.
     /// @param framenumber The number of the frame to write to. 0-7.
-    void pixelBufferWriteAllToFrame( uint8_t framenumber );
+    /// @return PIMORONI_11X7MATRIX_OK, PIMORONI_11X7MATRIX_ERROR_BUSY while a pusher is streaming to this frame, or an error code.
+    uint8_t pixelBufferWriteAllToFrame( uint8_t framenumber );
 
 
     /// @brief Write the pixel state buffer to a frame on the chip.
+    /// Only the columns changed since the last write to this frame are sent.
     /// @param framenubmer The number of the frame to write. 0-7.
-    void pixelBufferStateWriteToFrame( uint8_t framenumber );
+    /// @return PIMORONI_11X7MATRIX_OK, PIMORONI_11X7MATRIX_ERROR_BUSY while a pusher is streaming to this frame, or an error code.
+    uint8_t pixelBufferStateWriteToFrame( uint8_t framenumber );
 
     /// @brief Write the pixel blink state buffer to a frame on the chip.
+    /// Only the columns changed since the last write to this frame are sent.
     /// @param framenumber The number of the frame to write to. 0-7.
-    void pixelBufferBlinkStateWriteToFrame( uint8_t framenumber );
+    /// @return PIMORONI_11X7MATRIX_OK, PIMORONI_11X7MATRIX_ERROR_BUSY while a pusher is streaming to this frame, or an error code.
+    uint8_t pixelBufferBlinkStateWriteToFrame( uint8_t framenumber );
 
     /// @brief Write the pixel pwm state buffer to a frame on the chip.
+    /// Only the columns changed since the last write to this frame are sent, and neighbouring
+    /// columns are merged into one write by padding over the unused 8th register.
     /// @param framenumber The number of the frame to write to. 0-7.
-    void pixelBufferpwmStateWriteToFrame( uint8_t framenumber );
+    /// @return PIMORONI_11X7MATRIX_OK, PIMORONI_11X7MATRIX_ERROR_BUSY while a pusher is streaming to this frame, or an error code.
+    uint8_t pixelBufferpwmStateWriteToFrame( uint8_t framenumber );
+
+
+
+
+    /// @brief Start double buffering between two hardware frames.
+    /// Draw into the pixel buffers as usual, then present() uploads them to the hidden back frame
+    /// and flips the display pointer to it, so nothing half drawn is ever shown.
+    /// The front frame is put on display straight away, even inside beginUpdate().
+    /// @param frontframe The frame to show now. 0-7.
+    /// @param backframe The frame to draw into first. 0-7, not the same as frontframe.
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t doubleBufferBegin( uint8_t frontframe = 0 , uint8_t backframe = 1 );
+
+    /// @brief Stop double buffering.  Whatever is on display stays there.
+    void doubleBufferEnd();
+
+    /// @brief Upload the pixel buffers to the back frame, then show it with one display pointer write.
+    /// Only the columns that changed since that frame was last written are sent.
+    /// The frames then swap over, so the next present() draws into the one that was showing.
+    /// If the upload fails the display is left alone, and the unsent columns go out next time.
+    /// The display pointer is written straight away, even inside beginUpdate().
+    /// Without doubleBufferBegin() this just writes to the frame on display.
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t present();
+
+    /// @brief Gets the frame present() will upload to next.
+    /// @return The back frame while double buffering, otherwise the frame on display. 0-7.
+    uint8_t backFrameGet();
+
+
+
+
+    /// @brief Start brightness only mode, where the pwm value alone says whether a pixel is lit.
+    /// Every state bit is turned on, and goes out to each frame once, after that only pwm is sent.
+    /// pixelSet() and the state clear and fill functions work on the pwm buffer instead,
+    /// off is pwm 0, and on leaves a lit pixel alone or turns a dark one up to 255.
+    /// Pixels that were off are given pwm 0, so the picture does not change.
+    /// Fades then only dirty the pwm buffer, one upload per step instead of two.
+    void brightnessOnlyBegin();
+
+    /// @brief Stop brightness only mode.  Each state bit is set from whether its pwm is above 0, so the picture does not change.
+    void brightnessOnlyEnd();
+
+    /// @brief Checks if brightness only mode is on.
+    /// @return 1 if it is, 0 if not.
+    uint8_t brightnessOnlyGet();
+
+
+
+
+    /// @brief Put every pwm value through a gamma curve as it is sent, so even steps look even.
+    /// The pixel buffers keep the values as set, the curve is looked up in flash as each byte goes out.
+    /// Changing it resends the pwm of every frame on its next write.
+    /// @param state 1 for on, 0 for off.
+    void gammaEnableSet( uint8_t state );
+
+    /// @brief Checks if the gamma curve is on.
+    /// @return 1 if it is, 0 if not.
+    uint8_t gammaEnableGet();
+
+    /// @brief Scale every pwm value as it is sent, before the gamma curve.
+    /// The pixel buffers keep the values as set.  Changing it resends the pwm of every frame on its next write.
+    /// @param brightness 0-255. 255 sends the values as they are.
+    void masterBrightnessSet( uint8_t brightness );
 
+    /// @brief Gets the master brightness.
+    /// @return 0-255.
+    uint8_t masterBrightnessGet();
 
 
 
+
+    /// @brief Read a frame back from the chip, undoing the column interleave.
+    /// The whole frame comes back in 4 reads with the 32 byte avr buffer.
+    /// @param framenumber The number of the frame to read. 0-7.
+    /// @param buffer Where to put the frame.
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t frameReadback( uint8_t framenumber , Pimoroni_11x7matrixFrameBuffer *buffer );
+
+    /// @brief Read a frame back from the chip into the pixel buffers.
+    /// The frame read is marked as up to date, anything that changed is marked dirty for the other frames.
+    /// In brightness only mode the state read is folded into the pwm values, and the state buffer left all on.
+    /// The pwm comes back as the chip holds it, so with gamma or master brightness on it is not what was set.
+    /// @param framenumber The number of the frame to read. 0-7.
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t pixelBufferReadFromFrame( uint8_t framenumber );
+
+    /// @brief Check a frame on the chip matches the pixel buffers, pwm after the master brightness and gamma.
+    /// @param framenumber The number of the frame to check. 0-7.
+    /// @return PIMORONI_11X7MATRIX_OK if it matches, PIMORONI_11X7MATRIX_ERROR_VERIFY if not, or a bus error code.
+    uint8_t pixelBufferVerifyFrame( uint8_t framenumber );
+
+    /// @brief Read the control registers back from the chip into the shadow copy.
+    /// Changes waiting for commit() are kept. The frame state register 0x07 is left alone, so a pending
+    /// frame interrupt is still there for frameDisplayInterruptGet().
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t controlRegisterReadback();
+
+
+
+
+    /// @brief Marks the whole pixel buffer as changed for every frame, so the next writes send everything.
+    /// Use this if the chip has been reset or written to by someone else.
+    void pixelBufferInvalidate();
+
+
     /// @brief Sets the pixel buffers for state, blink and pwm to all zero.
+    /// In brightness only mode the state buffer stays all on.
     void pixelBufferClearAll();
 
 
     /// @brief Sets the pixel buffer for state to all zero.
+    /// In brightness only mode this turns every pixel's pwm to 0 instead.
     void pixelBufferStateClear();
 
     /// @brief Sets the pixel buffer for blink state to all zero.
@@ -167,6 +853,7 @@ class Pimoroni_11x7matrix {
 
 
     /// @brief Set all pixels state to the given value.
+    /// In brightness only mode this works on the pwm values instead, like pixelSet().
     /// @param data 0 = off, 1 = on.
     void pixelBufferStateFill( uint8_t data );
 
@@ -186,13 +873,27 @@ class Pimoroni_11x7matrix {
 
 
 
+    /// @brief Set which way up the board is mounted.  The pixel functions below work the right way up from then on.
+    /// The lookup happens as each pixel is set, so draw again after changing it.
+    /// Frame reads and verifies are always the chip's way up.
+    /// @param orientation PIMORONI_11X7MATRIX_ROTATE_0 or PIMORONI_11X7MATRIX_ROTATE_180, or'd with PIMORONI_11X7MATRIX_FLIP_X and PIMORONI_11X7MATRIX_FLIP_Y.
+    /// @return 1 if it was set, 0 if it was a quarter turn, which won't fit an 11x7 board.  Use a canvas for those.
+    uint8_t orientationSet( uint8_t orientation );
+
+    /// @brief Gets which way up the board is mounted.
+    /// @return The orientation given to orientationSet().
+    uint8_t orientationGet();
+
+
     /// @brief Sets a pixel to on or off in the pixel buffer.
+    /// In brightness only mode this sets the pwm value instead, see brightnessOnlyBegin().
     /// @param xpos The x position, with zero at the bottom left.
     /// @param ypos The y position, with the zero at the bottom left.
     /// @param state The state, 1 for on, 0 for off.
     void pixelSet( uint8_t xpos , uint8_t ypos , uint8_t state );
 
     /// @brief Gets the value of a pixel from the pixel buffer.
+    /// In brightness only mode a pixel is on if its pwm value is above 0.
     /// @param xpos The x position, with zero at the bottom left.
     /// @param ypos The y position, with zero at the bottom left.
     /// @return The state of the pixel as a uint8_t.  0 for off, 1 for on.
@@ -239,12 +940,29 @@ class Pimoroni_11x7matrix {
 
 
     // register config functions
+    // setters write straight through to the chip, getters answer from the shadow copy.
+    // the frame display state register 0x07 is read only, so it is always read from the chip.
+
+
+
+    /// @brief Start collecting control register changes instead of writing them straight away.
+    /// Setters called before the matching commit() only update the shadow copy.  Calls may nest.
+    void beginUpdate();
+
+    /// @brief Send every control register changed since beginUpdate() in one auto increment write.
+    /// Changes to the same register are merged, and the range between the first and last
+    /// changed register is written as a single transaction.
+    /// The update is over either way.  Outside an update, commit() sends whatever an earlier failure left behind.
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.  On failure the changes are kept for the next commit().
+    uint8_t commit();
+
 
     // 0x00 configuration register
 
     /// @brief Sets the display mode on the chip.
     /// @param mode The mode number to set. 0b00 = picture mode, 0b01 = auto frame play, 0b1x = audio frame play.
-    void displayModeSet( uint8_t mode );
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t displayModeSet( uint8_t mode );
 
     /// @brief Gets the display mode from the chip.
     /// @return The current display mode number as a uint8_t. 0b00 = picture mode, 0b01 = auto frame play, 0b1x = audio frame play.
@@ -252,7 +970,8 @@ class Pimoroni_11x7matrix {
 
     /// @brief Sets the start frame for autoplay
     /// @param startframe The number of the frame to syart autoplay on. 0-7.
-    void autoplayFrameStartSet( uint8_t startframe );
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t autoplayFrameStartSet( uint8_t startframe );
 
     /// @brief Gets the start frame for autoplay
     /// @return The number of the frame to start autoplay on as a uint8_t. 0-7.
@@ -266,7 +985,8 @@ class Pimoroni_11x7matrix {
 
     /// @brief Set the chips frame display pointer
     /// @param framenumber The number of the frame to display. 0-7.
-    void frameDisplayPointerSet( uint8_t framenumber );
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t frameDisplayPointerSet( uint8_t framenumber );
 
 
     /// @brief Fetches the current frame display pointer from the chip.
@@ -280,7 +1000,8 @@ class Pimoroni_11x7matrix {
 
     /// @brief Sets the number of loops to play in Auto frame Play mode.
     /// @param numberofloops The number of loops to play. 0 = infinite, 1-7 plays that many loops.
-    void autoplayNumberOfLoopsSet( uint8_t numberofloops );
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t autoplayNumberOfLoopsSet( uint8_t numberofloops );
 
     /// @brief Gets the number of loops to play in Auto Frame Play mode.
     /// @return The number of loops to play.  0 = infinite, 1-7 plays that many loops.
@@ -289,7 +1010,8 @@ class Pimoroni_11x7matrix {
 
     /// @brief Sets the number of frames to play in Auto Frame Play mode.
     /// @param  numberofframes The number of frames to play. 0 = all frames, 1-7 = that many frames.
-    void autoplayNumberOfFramesPlayingSet( uint8_t numberofframes );
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t autoplayNumberOfFramesPlayingSet( uint8_t numberofframes );
 
     /// @brief Gets the number of frames to play in an Auto Frame Play mode.
     /// @return The number of frames to play as a uint8_t. 0 = all framed, 1-7 = that many frames.
@@ -301,7 +1023,8 @@ class Pimoroni_11x7matrix {
 
     /// @brief Sets the frame delay time for Auto Frame Play mode.
     /// @param framedelaytime The time each frame should be shown.
-    void autoplayFrameDelayTimeSet( uint8_t framedelaytime );
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t autoplayFrameDelayTimeSet( uint8_t framedelaytime );
 
     /// @brief Gets the frame delay time for Auto Frame Play mode.
     /// @return The frame delay time as a uint8_t.
@@ -314,7 +1037,8 @@ class Pimoroni_11x7matrix {
 
     /// @brief Sets the intensity control bit.
     /// @param intensitystate 0 = set the intensity of each frame independently.  1 = use frame 0 for all settings.
-    void intensityControlSet( uint8_t intensitystate );
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t intensityControlSet( uint8_t intensitystate );
 
     /// @brief Gets the intensity control bit.
     /// @return The intensity control bit, as a uint8_1. 0 = set the intensity of each frame independently.  1 = use frame 0 for all settings.
@@ -322,7 +1046,8 @@ class Pimoroni_11x7matrix {
 
     /// @brief Enable blinking!
     /// @param blinkstate The blink state. 0 for disabled, 1 for enabled.
-    void blinkEnableSet( uint8_t blinkstate );
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t blinkEnableSet( uint8_t blinkstate );
 
     /// @brief Get the current blink state.
     /// @return The current blink enable state as a uint8_t. 0 for disabled, 1 for enabled.
@@ -330,7 +1055,8 @@ class Pimoroni_11x7matrix {
 
     /// @brief Sets the blink period time.
     /// @param  blinkperiodtime The amount of time to spend on each blink. 0-7 = bpt * 0.27s
-    void blinkPeriodTimeSet( uint8_t blinkperiodtime );
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t blinkPeriodTimeSet( uint8_t blinkperiodtime );
 
     /// @brief Gets the blink period time
     /// @return The blink period time multiplier, as a uint8_t.  0-7 = bpt * 0.27s
@@ -342,7 +1068,8 @@ class Pimoroni_11x7matrix {
 
     /// @brief Set the Audio Synchronisaton state.
     /// @param state The desired state as a uint8_t. 0 = disable, 1 = enable.
-    void audioSynchEnableSet( uint8_t state );
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t audioSynchEnableSet( uint8_t state );
 
     /// @brief Get the Audio Synchronisation state.
     /// @return The desired state as a uint8_t.  0 = disabled, 1 = enabled.
@@ -368,7 +1095,8 @@ class Pimoroni_11x7matrix {
 
     /// @brief Sets the fade out time for breath control
     /// @param fadeouttime 0-7. interval 26ms.
-    void breathControlFadeOutTimeSet( uint8_t fadetime );
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t breathControlFadeOutTimeSet( uint8_t fadetime );
 
     /// @brief Gets the fade out time for breath control.
     /// @return 0-7. interval 26ms.
@@ -377,7 +1105,8 @@ class Pimoroni_11x7matrix {
 
     /// @brief Sets the fade in time for breath control.
     /// @param fadeintime 0-7. interval 26ms.
-    void breathControlFadeInTimeSet( uint8_t fadetime );
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t breathControlFadeInTimeSet( uint8_t fadetime );
 
     /// @brief Gets the fade in time for breath control.
     /// @return 0-7. interval 26ms.
@@ -388,7 +1117,8 @@ class Pimoroni_11x7matrix {
 
     /// @brief Sets the enable flaf for the Breath Control system.
     /// @param state 0 = disable , 1 = enable.
-    void breathControlEnableSet( uint8_t state );
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t breathControlEnableSet( uint8_t state );
 
     /// @brief Gets the enable flag for the Breath Control system.
     /// @return 0 = disable , 1 = enable.
@@ -397,7 +1127,8 @@ class Pimoroni_11x7matrix {
 
     /// @brief Sets the time off, between fade out and fade in, for the Breath Control system.
     /// @param fadetime 0-7. interval 3.5ms.
-    void breathControlExtinguishTimeSet( uint8_t fadetime );
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t breathControlExtinguishTimeSet( uint8_t fadetime );
 
     /// @brief Gets the time off, between fade out and fade in, for the Breath Control system.
     /// @return 0-7. interval 3.5ms
@@ -413,7 +1144,8 @@ class Pimoroni_11x7matrix {
 
     /// @brief Sets the software shutdown flag on the chip.
     /// @param state The state to set as a uint8_t. 0 = shutdown, 1 = normal operation.
-    void softwareShutdownSet( uint8_t state );
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t softwareShutdownSet( uint8_t state );
 
     /// @brief Gets the software shutdown flag from the chip.
     /// @return the flag as a uint8_t. 0 = shutdown, 1 = normal operation.
@@ -425,7 +1157,8 @@ class Pimoroni_11x7matrix {
 
     /// @brief Set the AGC mode.
     /// @param state 0 = slow mode, 1 = fast mode.
-    void audioagcModeSet( uint8_t state );
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t audioagcModeSet( uint8_t state );
 
     /// @brief Get the AGC mode.
     /// @return 0 = slow mode, 1 = fast mode.
@@ -433,7 +1166,8 @@ class Pimoroni_11x7matrix {
 
     /// @brief Set the enable flag for AGC.
     /// @param state 0 = disable, 1 = enable.
-    void audioagcEnableSet( uint8_t state );
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t audioagcEnableSet( uint8_t state );
 
     /// @brief Get the enable flag for AGC.
     /// @return 0 = disable, 1 = enable.
@@ -441,7 +1175,8 @@ class Pimoroni_11x7matrix {
 
     /// @brief Sets the gain for the AGC
     /// @param gain 0-7, interval 3dB
-    void audioagcGainSet( uint8_t gain );
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t audioagcGainSet( uint8_t gain );
 
     /// @brief Gets the gain for AGC.
     /// @return 0-7, interval 3dB.
@@ -455,7 +1190,8 @@ class Pimoroni_11x7matrix {
 
     /// @brief Sets the ADC sample rate.
     /// @param samplerate 0-255, interval 46us
-    void audioadcSampleRateSet( uint8_t samplerate );
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t audioadcSampleRateSet( uint8_t samplerate );
 
     /// @brief Gets the ADC sample rate.
     /// @return 0-255, interval 46us
@@ -473,6 +1209,14 @@ class Pimoroni_11x7matrix {
 
 
 
+// the driver for the usual Wire bus, built once in pimoroni_11x7matrix.cpp.
+extern template class Pimoroni_11x7matrixT< Pimoroni_11x7matrixWireTransport >;
+typedef Pimoroni_11x7matrixT< Pimoroni_11x7matrixWireTransport > Pimoroni_11x7matrix;
+
+
+
+
+
 
 
 
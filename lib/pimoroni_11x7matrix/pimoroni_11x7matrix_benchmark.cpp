@@ -0,0 +1,11 @@
+// include my header
+#include <pimoroni_11x7matrix_benchmark.h>
+
+// and the implementation
+#include <pimoroni_11x7matrix_benchmark_impl.h>
+
+
+
+
+// build the benchmarks for the usual Wire bus
+template class Pimoroni_11x7matrixBenchmarkT< Pimoroni_11x7matrixWireTransport >;
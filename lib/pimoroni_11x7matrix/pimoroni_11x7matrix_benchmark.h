@@ -0,0 +1,122 @@
+#ifndef PIMORONI_11X7MATRIX_BENCHMARK_HEADER_GUARD
+#define PIMORONI_11X7MATRIX_BENCHMARK_HEADER_GUARD
+
+
+// benchmarks for the 11x7 matrix driver
+//
+// times the upload and configuration paths with micros(), on the device or against the simulated bus on a linux host.
+// results print over Serial as comma separated lines, one per test, starting with "bench," so they are easy to pick out:
+//
+//   bench,test,busclock,iterations,us_per_call,calls_per_second
+
+// pull in the matrix driver
+#include <pimoroni_11x7matrix.h>
+
+
+// the tests
+#define PIMORONI_11X7MATRIX_BENCH_BEGIN 0
+#define PIMORONI_11X7MATRIX_BENCH_WRITE_ALL 1
+#define PIMORONI_11X7MATRIX_BENCH_WRITE_STATE 2
+#define PIMORONI_11X7MATRIX_BENCH_WRITE_PWM 3
+#define PIMORONI_11X7MATRIX_BENCH_WRITE_PIXEL 4
+#define PIMORONI_11X7MATRIX_BENCH_AUTOPLAY 5
+
+// the number of tests
+#define PIMORONI_11X7MATRIX_BENCH_COUNT 6
+
+
+
+
+/// @brief How one benchmark test went.
+struct Pimoroni_11x7matrixBenchmarkResult {
+
+    /// @brief The bus clock begin() settled on, in hz.
+    uint32_t busclock;
+
+    /// @brief How many times the call was timed.
+    uint16_t iterations;
+
+    /// @brief Time spent in the call, over all iterations, in micros().
+    uint32_t microseconds;
+
+    /// @brief PIMORONI_11X7MATRIX_OK, or the first error the call returned.
+    uint8_t status;
+
+};
+
+
+
+
+/// @brief Times the upload and configuration paths of a matrix.
+/// Use Pimoroni_11x7matrixBenchmark with the usual Pimoroni_11x7matrix.
+/// Each test times only the call being measured, the setup around it is left out.
+///   begin        the whole begin() sequence.
+///   write_all    pixelBufferWriteAllToFrame() of a whole frame.
+///   write_state  pixelBufferStateWriteToFrame() of a whole frame.
+///   write_pwm    pixelBufferpwmStateWriteToFrame() of a whole frame.
+///   write_pixel  pixelBufferWriteAllToFrame() after changing one pixel.
+///   autoplay     filling all 8 frames and setting up auto frame play, the way menucommand_04 does.
+template< class Transport >
+class Pimoroni_11x7matrixBenchmarkT {
+
+
+    private:
+
+    /// @brief The matrix to benchmark.
+    Pimoroni_11x7matrixT< Transport > *_matrix;
+
+    /// @brief How each test went on the last run.
+    Pimoroni_11x7matrixBenchmarkResult _results[ PIMORONI_11X7MATRIX_BENCH_COUNT ];
+
+    /// @brief Time one call, adding it to a result.
+    /// @param result The result to add to.
+    /// @param starttime micros() when the call started.
+    /// @param status What the call returned.
+    void _resultAdd( Pimoroni_11x7matrixBenchmarkResult *result , uint32_t starttime , uint8_t status );
+
+    /// @brief Fill all 8 frames and set up auto frame play, the way menucommand_04 does.
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t _autoplayConfigure();
+
+
+
+    public:
+
+    /// @brief Constructor for the benchmarks.
+    /// @param matrix The matrix to benchmark.  begin() is called on it by run().
+    Pimoroni_11x7matrixBenchmarkT( Pimoroni_11x7matrixT< Transport > &matrix );
+
+
+    /// @brief Run every test at one bus clock.
+    /// @param new_i2c_address The i2c address of the chip.
+    /// @param busclock The bus clock to ask begin() for, in hz.  It may settle on a slower one.
+    /// @param iterations How many times to time each call.
+    /// @return PIMORONI_11X7MATRIX_OK, or the first error a test hit.
+    uint8_t run( uint8_t new_i2c_address , uint32_t busclock , uint16_t iterations );
+
+    /// @brief Gets how a test went on the last run.
+    /// @param test The test, PIMORONI_11X7MATRIX_BENCH_BEGIN and so on.
+    /// @param result Where to put the result.
+    void resultGet( uint8_t test , Pimoroni_11x7matrixBenchmarkResult *result );
+
+    /// @brief Print the column names over Serial.
+    void printHeader();
+
+    /// @brief Print the results of the last run over Serial, one line per test.
+    void print();
+
+};
+
+
+
+
+// the benchmarks for the usual Wire bus, built once in pimoroni_11x7matrix_benchmark.cpp.
+extern template class Pimoroni_11x7matrixBenchmarkT< Pimoroni_11x7matrixWireTransport >;
+typedef Pimoroni_11x7matrixBenchmarkT< Pimoroni_11x7matrixWireTransport > Pimoroni_11x7matrixBenchmark;
+
+
+
+
+
+
+#endif
@@ -0,0 +1,253 @@
+#ifndef PIMORONI_11X7MATRIX_BENCHMARK_IMPL_HEADER_GUARD
+#define PIMORONI_11X7MATRIX_BENCHMARK_IMPL_HEADER_GUARD
+
+
+// implementation of the benchmark template.
+// pimoroni_11x7matrix_benchmark.cpp builds it for the default wire transport, include this yourself to build it for another transport.
+
+// include my header
+#include <pimoroni_11x7matrix_benchmark.h>
+
+
+
+
+/// @brief Constructor for the benchmarks.
+/// @param matrix The matrix to benchmark.
+template< class Transport >
+Pimoroni_11x7matrixBenchmarkT< Transport >::Pimoroni_11x7matrixBenchmarkT( Pimoroni_11x7matrixT< Transport > &matrix ) {
+
+    _matrix = &matrix;
+
+    // nothing run yet
+    memset( _results , 0 , sizeof( _results ) );
+
+}
+
+
+
+
+/// @brief Time one call, adding it to a result.
+/// @param result The result to add to.
+/// @param starttime micros() when the call started.
+/// @param status What the call returned.
+template< class Transport >
+void Pimoroni_11x7matrixBenchmarkT< Transport >::_resultAdd( Pimoroni_11x7matrixBenchmarkResult *result , uint32_t starttime , uint8_t status ) {
+
+    result->microseconds += micros() - starttime;
+    result->iterations++;
+
+    // hang on to the first thing that went wrong
+    if ( !result->status ) { result->status = status; }
+
+    // all done, return to caller
+    return;
+
+}
+
+
+/// @brief Fill all 8 frames and set up auto frame play, the way menucommand_04 does.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixBenchmarkT< Transport >::_autoplayConfigure() {
+
+    // the state, blink and pwm fill for each frame
+    const uint8_t framestate[ 8 ] = { 0xFF , 0xFF , 0xAA , 0x55 , 0xFF , 0xFF , 0xFF , 0xFF };
+    const uint8_t frameblink[ 8 ] = { 0x00 , 0xFF , 0x00 , 0x00 , 0x00 , 0x00 , 0x00 , 0x00 };
+    const uint8_t framepwm[ 8 ] = { 0x04 , 0x04 , 0x04 , 0x04 , 0x04 , 0x02 , 0x04 , 0x08 };
+
+    uint8_t status = _matrix->softwareShutdownSet( 0 );
+    if ( status ) { return status; }
+
+    for ( uint8_t framenumber = 0 ; framenumber < 8 ; framenumber++ ) {
+
+        _matrix->pixelBufferStateFill( framestate[ framenumber ] );
+        _matrix->pixelBufferBlinkStateFill( frameblink[ framenumber ] );
+        _matrix->pixelBufferpwmStateFill( framepwm[ framenumber ] );
+
+        status = _matrix->pixelBufferWriteAllToFrame( framenumber );
+        if ( status ) { return status; }
+
+    }
+
+    // then the registers, in one go
+    _matrix->beginUpdate();
+
+    _matrix->blinkEnableSet( 1 );
+    _matrix->blinkPeriodTimeSet( 1 );
+    _matrix->breathControlEnableSet( 0 );
+    _matrix->breathControlFadeInTimeSet( 3 );
+    _matrix->breathControlExtinguishTimeSet( 1 );
+    _matrix->breathControlFadeOutTimeSet( 3 );
+    _matrix->frameDisplayPointerSet( 0 );
+    _matrix->autoplayFrameStartSet( 0 );
+    _matrix->autoplayNumberOfFramesPlayingSet( 0 );
+    _matrix->autoplayNumberOfLoopsSet( 0 );
+    _matrix->autoplayFrameDelayTimeSet( 0 );
+    _matrix->displayModeSet( 0b01 );
+    _matrix->softwareShutdownSet( 1 );
+
+    return _matrix->commit();
+
+}
+
+
+
+
+/// @brief Run every test at one bus clock.
+/// @param new_i2c_address The i2c address of the chip.
+/// @param busclock The bus clock to ask begin() for, in hz.  It may settle on a slower one.
+/// @param iterations How many times to time each call.
+/// @return PIMORONI_11X7MATRIX_OK, or the first error a test hit.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixBenchmarkT< Transport >::run( uint8_t new_i2c_address , uint32_t busclock , uint16_t iterations ) {
+
+    memset( _results , 0 , sizeof( _results ) );
+
+    uint32_t starttime;
+    uint8_t status;
+
+    // the whole begin() sequence
+    for ( uint16_t i = 0 ; i < iterations ; i++ ) {
+
+        starttime = micros();
+        status = _matrix->begin( new_i2c_address , busclock );
+        _resultAdd( &_results[ PIMORONI_11X7MATRIX_BENCH_BEGIN ] , starttime , status );
+
+        // no point carrying on without a chip
+        if ( status ) { return status; }
+
+    }
+
+    // something to look at while the uploads run
+    _matrix->pixelBufferStateFill( 0x7F );
+    _matrix->pixelBufferpwmStateFill( 0x10 );
+
+    // whole frames, everything marked as changed first
+    for ( uint16_t i = 0 ; i < iterations ; i++ ) {
+
+        _matrix->pixelBufferInvalidate();
+        starttime = micros();
+        status = _matrix->pixelBufferWriteAllToFrame( 0 );
+        _resultAdd( &_results[ PIMORONI_11X7MATRIX_BENCH_WRITE_ALL ] , starttime , status );
+
+        _matrix->pixelBufferInvalidate();
+        starttime = micros();
+        status = _matrix->pixelBufferStateWriteToFrame( 0 );
+        _resultAdd( &_results[ PIMORONI_11X7MATRIX_BENCH_WRITE_STATE ] , starttime , status );
+
+        _matrix->pixelBufferInvalidate();
+        starttime = micros();
+        status = _matrix->pixelBufferpwmStateWriteToFrame( 0 );
+        _resultAdd( &_results[ PIMORONI_11X7MATRIX_BENCH_WRITE_PWM ] , starttime , status );
+
+    }
+
+    // the usual animation case, one pixel changed since the last upload
+    _matrix->pixelBufferWriteAllToFrame( 0 );
+
+    for ( uint16_t i = 0 ; i < iterations ; i++ ) {
+
+        uint8_t xpos = i % 11;
+        uint8_t ypos = i % 7;
+
+        _matrix->pixelSet( xpos , ypos , !_matrix->pixelGet( xpos , ypos ) );
+        starttime = micros();
+        status = _matrix->pixelBufferWriteAllToFrame( 0 );
+        _resultAdd( &_results[ PIMORONI_11X7MATRIX_BENCH_WRITE_PIXEL ] , starttime , status );
+
+    }
+
+    // all 8 frames and the autoplay registers
+    for ( uint16_t i = 0 ; i < iterations ; i++ ) {
+
+        starttime = micros();
+        status = _autoplayConfigure();
+        _resultAdd( &_results[ PIMORONI_11X7MATRIX_BENCH_AUTOPLAY ] , starttime , status );
+
+    }
+
+    // tell the caller about the first thing that went wrong
+    for ( uint8_t test = 0 ; test < PIMORONI_11X7MATRIX_BENCH_COUNT ; test++ ) {
+
+        _results[ test ].busclock = _matrix->busClockGet();
+        if ( _results[ test ].status ) { return _results[ test ].status; }
+
+    }
+
+    return PIMORONI_11X7MATRIX_OK;
+
+}
+
+
+/// @brief Gets how a test went on the last run.
+/// @param test The test, PIMORONI_11X7MATRIX_BENCH_BEGIN and so on.
+/// @param result Where to put the result.
+template< class Transport >
+void Pimoroni_11x7matrixBenchmarkT< Transport >::resultGet( uint8_t test , Pimoroni_11x7matrixBenchmarkResult *result ) {
+
+    if ( test < PIMORONI_11X7MATRIX_BENCH_COUNT ) { *result = _results[ test ]; }
+    else { memset( result , 0 , sizeof( Pimoroni_11x7matrixBenchmarkResult ) ); }
+
+    // all done, return to caller
+    return;
+
+}
+
+
+/// @brief Print the column names over Serial.
+template< class Transport >
+void Pimoroni_11x7matrixBenchmarkT< Transport >::printHeader() {
+
+    Serial.println( F( "bench,test,busclock,iterations,us_per_call,calls_per_second" ) );
+
+}
+
+
+/// @brief Print the results of the last run over Serial, one line per test.
+template< class Transport >
+void Pimoroni_11x7matrixBenchmarkT< Transport >::print() {
+
+    for ( uint8_t test = 0 ; test < PIMORONI_11X7MATRIX_BENCH_COUNT ; test++ ) {
+
+        const Pimoroni_11x7matrixBenchmarkResult *result = &_results[ test ];
+
+        Serial.print( F( "bench," ) );
+
+        switch ( test ) {
+
+            case PIMORONI_11X7MATRIX_BENCH_BEGIN: Serial.print( F( "begin" ) ); break;
+            case PIMORONI_11X7MATRIX_BENCH_WRITE_ALL: Serial.print( F( "write_all" ) ); break;
+            case PIMORONI_11X7MATRIX_BENCH_WRITE_STATE: Serial.print( F( "write_state" ) ); break;
+            case PIMORONI_11X7MATRIX_BENCH_WRITE_PWM: Serial.print( F( "write_pwm" ) ); break;
+            case PIMORONI_11X7MATRIX_BENCH_WRITE_PIXEL: Serial.print( F( "write_pixel" ) ); break;
+            default: Serial.print( F( "autoplay" ) ); break;
+
+        }
+
+        // a test that failed has no meaningful time
+        uint32_t percall = 0;
+        uint32_t persecond = 0;
+
+        if ( !result->status && result->iterations ) {
+
+            percall = result->microseconds / result->iterations;
+            if ( result->microseconds ) { persecond = (uint32_t)( ( 1000000ULL * result->iterations ) / result->microseconds ); }
+
+        }
+
+        Serial.print( ',' ); Serial.print( result->busclock );
+        Serial.print( ',' ); Serial.print( result->iterations );
+        Serial.print( ',' ); Serial.print( percall );
+        Serial.print( ',' ); Serial.println( persecond );
+
+    }
+
+    // all done, return to caller
+    return;
+
+}
+
+
+
+
+#endif
@@ -0,0 +1,11 @@
+// include my header
+#include <pimoroni_11x7matrix_canvas.h>
+
+// and the implementation
+#include <pimoroni_11x7matrix_canvas_impl.h>
+
+
+
+
+// build the canvas for the usual Wire bus
+template class Pimoroni_11x7matrixCanvasT< Pimoroni_11x7matrixWireTransport >;
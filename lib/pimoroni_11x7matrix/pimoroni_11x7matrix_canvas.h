@@ -0,0 +1,166 @@
+#ifndef PIMORONI_11X7MATRIX_CANVAS_HEADER_GUARD
+#define PIMORONI_11X7MATRIX_CANVAS_HEADER_GUARD
+
+
+// tiled canvas over several 11x7 matrix boards by pimoroni
+
+// pull in the matrix driver
+#include <pimoroni_11x7matrix.h>
+
+
+// the most boards a canvas can tile, the chip has 4 i2c addresses.  define it yourself to override.
+#ifndef PIMORONI_11X7MATRIX_CANVAS_MAX_TILES
+#define PIMORONI_11X7MATRIX_CANVAS_MAX_TILES 4
+#endif
+
+
+
+
+/// @brief Tiles several matrices into one display, with one coordinate space.
+/// Use Pimoroni_11x7matrixCanvas with the usual Pimoroni_11x7matrix.
+/// Tiles are laid out left to right, bottom to top, so 4 across makes 44x7 and 2 by 2 makes 22x14.
+/// Each matrix keeps its own pixel buffers and is started with its own begin(), the canvas just draws into them.
+/// flush() sends every board's dirty columns in one pass, a transaction from each in turn,
+/// so the boards update together instead of one after the other.
+template< class Transport >
+class Pimoroni_11x7matrixCanvasT {
+
+
+    private:
+
+    /// @brief The matrices, left to right then bottom to top.  NULL where there is no board.
+    Pimoroni_11x7matrixT< Transport > *_tiles[ PIMORONI_11X7MATRIX_CANVAS_MAX_TILES ];
+
+    /// @brief How many boards across.
+    uint8_t _tileswide;
+
+    /// @brief How many boards up.
+    uint8_t _tileshigh;
+
+    /// @brief The orientation set by orientationSet().
+    uint8_t _orientation;
+
+    /// @brief Where a pixel really is on the boards, worked out once by orientationSet().
+    /// Across is _xoffset + _xfromx * x + _xfromy * y, and up is _yoffset + _yfromx * x + _yfromy * y.
+    int8_t _xfromx;
+    int8_t _xfromy;
+    int8_t _yfromx;
+    int8_t _yfromy;
+    int16_t _xoffset;
+    int16_t _yoffset;
+
+    /// @brief Finds the board a pixel is on.
+    /// @param xpos The x position on the canvas, moved to the x position on the board.
+    /// @param ypos The y position on the canvas, moved to the y position on the board.
+    /// @return The board, or NULL if the pixel is off the canvas or there is no board there.
+    Pimoroni_11x7matrixT< Transport > *_tileFind( uint8_t *xpos , uint8_t *ypos );
+
+
+
+    public:
+
+    /// @brief Constructor for the canvas.
+    /// @param tileswide How many boards across.
+    /// @param tileshigh How many boards up.  tileswide * tileshigh must not be more than PIMORONI_11X7MATRIX_CANVAS_MAX_TILES.
+    Pimoroni_11x7matrixCanvasT( uint8_t tileswide , uint8_t tileshigh = 1 );
+
+
+    /// @brief Puts a board on the canvas.
+    /// @param tilex Which board across, 0 on the left.
+    /// @param tiley Which board up, 0 at the bottom.
+    /// @param matrix The board.
+    /// @return 1 if it was placed, 0 if that is off the canvas.
+    uint8_t tileSet( uint8_t tilex , uint8_t tiley , Pimoroni_11x7matrixT< Transport > &matrix );
+
+    /// @brief Gets the width of the canvas.
+    /// @return The width in pixels, the way up orientationSet() says.
+    uint8_t widthGet();
+
+    /// @brief Gets the height of the canvas.
+    /// @return The height in pixels, the way up orientationSet() says.
+    uint8_t heightGet();
+
+
+    /// @brief Set which way up the canvas is mounted.  The pixel functions work the right way up from then on.
+    /// A quarter turn swaps the width and height, so 2 boards across become 7 wide and 22 high.
+    /// The sums are worked out here, so setting a pixel costs the same whichever way up it is.  Draw again after changing it.
+    /// Each board can still be given its own orientation for how it sits in the canvas, that is done first.
+    /// @param orientation One of the PIMORONI_11X7MATRIX_ROTATE values, or'd with PIMORONI_11X7MATRIX_FLIP_X and PIMORONI_11X7MATRIX_FLIP_Y.
+    void orientationSet( uint8_t orientation );
+
+    /// @brief Gets which way up the canvas is mounted.
+    /// @return The orientation given to orientationSet().
+    uint8_t orientationGet();
+
+
+
+
+    /// @brief Send the dirty parts of every board to a frame, interleaved.
+    /// Each pass sends one transaction to each board that still has something to send.
+    /// A board that fails keeps its dirty columns for next time, the others carry on.
+    /// @param framenumber The number of the frame to write to. 0-7.
+    /// @return PIMORONI_11X7MATRIX_OK, or the first error a board hit.
+    uint8_t flush( uint8_t framenumber );
+
+    /// @brief Show a frame on every board, one write each, back to back.
+    /// @param framenumber The number of the frame to display. 0-7.
+    /// @return PIMORONI_11X7MATRIX_OK, or the first error a board hit.
+    uint8_t frameDisplayPointerSet( uint8_t framenumber );
+
+
+
+
+    /// @brief Sets the pixel buffers of every board for state, blink and pwm to all zero.
+    void pixelBufferClearAll();
+
+    /// @brief Sets a pixel to on or off.
+    /// @param xpos The x position, with zero at the bottom left of the canvas.
+    /// @param ypos The y position, with zero at the bottom left of the canvas.
+    /// @param state The state, 1 for on, 0 for off.
+    void pixelSet( uint8_t xpos , uint8_t ypos , uint8_t state );
+
+    /// @brief Gets the state of a pixel.
+    /// @param xpos The x position, with zero at the bottom left of the canvas.
+    /// @param ypos The y position, with zero at the bottom left of the canvas.
+    /// @return 0 for off, 1 for on.  0 off the canvas.
+    uint8_t pixelGet( uint8_t xpos , uint8_t ypos );
+
+    /// @brief Set the blink flag for a pixel on or off.
+    /// @param xpos The x position, with zero at the bottom left of the canvas.
+    /// @param ypos The y position, with zero at the bottom left of the canvas.
+    /// @param state 0 for off, 1 for on.
+    void pixelBlinkSet( uint8_t xpos , uint8_t ypos , uint8_t state );
+
+    /// @brief Gets the blink flag of a pixel.
+    /// @param xpos The x position, with zero at the bottom left of the canvas.
+    /// @param ypos The y position, with zero at the bottom left of the canvas.
+    /// @return 0 for off, 1 for on.  0 off the canvas.
+    uint8_t pixelBlinkGet( uint8_t xpos , uint8_t ypos );
+
+    /// @brief Set the pwm value for a pixel.
+    /// @param xpos The x position, with zero at the bottom left of the canvas.
+    /// @param ypos The y position, with zero at the bottom left of the canvas.
+    /// @param state 0 is full off, 255 is full on.
+    void pixelpwmSet( uint8_t xpos , uint8_t ypos , uint8_t state );
+
+    /// @brief Gets the pwm value for a pixel.
+    /// @param xpos The x position, with zero at the bottom left of the canvas.
+    /// @param ypos The y position, with zero at the bottom left of the canvas.
+    /// @return 0 is full off, 255 is full on.  0 off the canvas.
+    uint8_t pixelpwmGet( uint8_t xpos , uint8_t ypos );
+
+};
+
+
+
+
+// the canvas for the usual Wire bus, built once in pimoroni_11x7matrix_canvas.cpp.
+extern template class Pimoroni_11x7matrixCanvasT< Pimoroni_11x7matrixWireTransport >;
+typedef Pimoroni_11x7matrixCanvasT< Pimoroni_11x7matrixWireTransport > Pimoroni_11x7matrixCanvas;
+
+
+
+
+
+
+#endif
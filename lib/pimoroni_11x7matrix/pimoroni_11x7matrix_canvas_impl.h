@@ -0,0 +1,368 @@
+#ifndef PIMORONI_11X7MATRIX_CANVAS_IMPL_HEADER_GUARD
+#define PIMORONI_11X7MATRIX_CANVAS_IMPL_HEADER_GUARD
+
+
+// implementation of the tiled canvas template.
+// pimoroni_11x7matrix_canvas.cpp builds it for the default wire transport, include this yourself to build it for another transport.
+
+// include my header
+#include <pimoroni_11x7matrix_canvas.h>
+
+
+
+
+/// @brief Constructor for the canvas.
+/// @param tileswide How many boards across.
+/// @param tileshigh How many boards up.
+template< class Transport >
+Pimoroni_11x7matrixCanvasT< Transport >::Pimoroni_11x7matrixCanvasT( uint8_t tileswide , uint8_t tileshigh ) {
+
+    // never more than we have room for
+    if ( !tileswide ) { tileswide = 1; }
+    if ( !tileshigh ) { tileshigh = 1; }
+    if ( tileswide > PIMORONI_11X7MATRIX_CANVAS_MAX_TILES ) { tileswide = PIMORONI_11X7MATRIX_CANVAS_MAX_TILES; }
+    if ( tileswide * tileshigh > PIMORONI_11X7MATRIX_CANVAS_MAX_TILES ) { tileshigh = PIMORONI_11X7MATRIX_CANVAS_MAX_TILES / tileswide; }
+
+    _tileswide = tileswide;
+    _tileshigh = tileshigh;
+
+    // no boards yet
+    for ( uint8_t i = 0 ; i < PIMORONI_11X7MATRIX_CANVAS_MAX_TILES ; i++ ) { _tiles[ i ] = NULL; }
+
+    // the right way up
+    orientationSet( PIMORONI_11X7MATRIX_ROTATE_0 );
+
+}
+
+
+
+
+/// @brief Finds the board a pixel is on.
+/// @param xpos The x position on the canvas, moved to the x position on the board.
+/// @param ypos The y position on the canvas, moved to the y position on the board.
+/// @return The board, or NULL if the pixel is off the canvas or there is no board there.
+template< class Transport >
+Pimoroni_11x7matrixT< Transport > *Pimoroni_11x7matrixCanvasT< Transport >::_tileFind( uint8_t *xpos , uint8_t *ypos ) {
+
+    // where it really is.  anything off the canvas lands off the boards.
+    int16_t physx = _xoffset + _xfromx * *xpos + _xfromy * *ypos;
+    int16_t physy = _yoffset + _yfromx * *xpos + _yfromy * *ypos;
+
+    if ( ( physx < 0 ) || ( physy < 0 ) ) { return NULL; }
+
+    uint8_t tilex = physx / 11;
+    uint8_t tiley = physy / 7;
+
+    if ( ( tilex >= _tileswide ) || ( tiley >= _tileshigh ) ) { return NULL; }
+
+    *xpos = physx - tilex * 11;
+    *ypos = physy - tiley * 7;
+
+    return _tiles[ tiley * _tileswide + tilex ];
+
+}
+
+
+
+
+/// @brief Puts a board on the canvas.
+/// @param tilex Which board across, 0 on the left.
+/// @param tiley Which board up, 0 at the bottom.
+/// @param matrix The board.
+/// @return 1 if it was placed, 0 if that is off the canvas.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixCanvasT< Transport >::tileSet( uint8_t tilex , uint8_t tiley , Pimoroni_11x7matrixT< Transport > &matrix ) {
+
+    if ( ( tilex >= _tileswide ) || ( tiley >= _tileshigh ) ) { return 0; }
+
+    _tiles[ tiley * _tileswide + tilex ] = &matrix;
+
+    return 1;
+
+}
+
+
+/// @brief Gets the width of the canvas.
+/// @return The width in pixels, the way up orientationSet() says.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixCanvasT< Transport >::widthGet() {
+
+    return ( _orientation & PIMORONI_11X7MATRIX_ROTATE_90 ) ? _tileshigh * 7 : _tileswide * 11;
+
+}
+
+
+/// @brief Gets the height of the canvas.
+/// @return The height in pixels, the way up orientationSet() says.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixCanvasT< Transport >::heightGet() {
+
+    return ( _orientation & PIMORONI_11X7MATRIX_ROTATE_90 ) ? _tileswide * 11 : _tileshigh * 7;
+
+}
+
+
+
+
+/// @brief Set which way up the canvas is mounted.
+/// @param orientation One of the PIMORONI_11X7MATRIX_ROTATE values, or'd with PIMORONI_11X7MATRIX_FLIP_X and PIMORONI_11X7MATRIX_FLIP_Y.
+template< class Transport >
+void Pimoroni_11x7matrixCanvasT< Transport >::orientationSet( uint8_t orientation ) {
+
+    _orientation = orientation;
+
+    // the size of the boards, and the size the caller sees
+    int16_t physwidth = _tileswide * 11;
+    int16_t physheight = _tileshigh * 7;
+    int16_t width = widthGet();
+    int16_t height = heightGet();
+
+    // the turn, from the flipped position to where it is on the boards
+    switch ( orientation & 0b00000011 ) {
+
+        case PIMORONI_11X7MATRIX_ROTATE_90:
+            _xfromx = 0; _xfromy = 1; _xoffset = 0;
+            _yfromx = -1; _yfromy = 0; _yoffset = physheight - 1;
+            break;
+
+        case PIMORONI_11X7MATRIX_ROTATE_180:
+            _xfromx = -1; _xfromy = 0; _xoffset = physwidth - 1;
+            _yfromx = 0; _yfromy = -1; _yoffset = physheight - 1;
+            break;
+
+        case PIMORONI_11X7MATRIX_ROTATE_270:
+            _xfromx = 0; _xfromy = -1; _xoffset = physwidth - 1;
+            _yfromx = 1; _yfromy = 0; _yoffset = 0;
+            break;
+
+        default:
+            _xfromx = 1; _xfromy = 0; _xoffset = 0;
+            _yfromx = 0; _yfromy = 1; _yoffset = 0;
+            break;
+
+    }
+
+    // then fold the flips in front of it, x becomes width - 1 - x
+    if ( orientation & PIMORONI_11X7MATRIX_FLIP_X ) {
+
+        _xoffset += _xfromx * ( width - 1 );
+        _yoffset += _yfromx * ( width - 1 );
+        _xfromx = -_xfromx;
+        _yfromx = -_yfromx;
+
+    }
+
+    if ( orientation & PIMORONI_11X7MATRIX_FLIP_Y ) {
+
+        _xoffset += _xfromy * ( height - 1 );
+        _yoffset += _yfromy * ( height - 1 );
+        _xfromy = -_xfromy;
+        _yfromy = -_yfromy;
+
+    }
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+/// @brief Gets which way up the canvas is mounted.
+/// @return The orientation given to orientationSet().
+template< class Transport >
+uint8_t Pimoroni_11x7matrixCanvasT< Transport >::orientationGet() {
+
+    return _orientation;
+
+}
+
+
+
+
+/// @brief Send the dirty parts of every board to a frame, interleaved.
+/// @param framenumber The number of the frame to write to. 0-7.
+/// @return PIMORONI_11X7MATRIX_OK, or the first error a board hit.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixCanvasT< Transport >::flush( uint8_t framenumber ) {
+
+    // what each board needs sending, and how far through it each one is.
+    Pimoroni_11x7matrixFrameMask masks[ PIMORONI_11X7MATRIX_CANVAS_MAX_TILES ];
+    uint8_t addresses[ PIMORONI_11X7MATRIX_CANVAS_MAX_TILES ];
+
+    uint8_t tilecount = _tileswide * _tileshigh;
+
+    for ( uint8_t i = 0 ; i < tilecount ; i++ ) {
+
+        // nothing to send where there is no board
+        addresses[ i ] = PIMORONI_11X7MATRIX_FRAME_LAST_REG + 1;
+        if ( !_tiles[ i ] ) { continue; }
+
+        _tiles[ i ]->_frameImageDirtyTake( framenumber , PIMORONI_11X7MATRIX_BUFFER_STATE | PIMORONI_11X7MATRIX_BUFFER_BLINK | PIMORONI_11X7MATRIX_BUFFER_PWM , &masks[ i ] );
+        addresses[ i ] = 0x00;
+
+    }
+
+    uint8_t firststatus = PIMORONI_11X7MATRIX_OK;
+    uint8_t busy = 1;
+
+    // one transaction to each board in turn, until they are all done.
+    // each board remembers its own selected page, so only the first run to each one selects it.
+    while ( busy ) {
+
+        busy = 0;
+
+        for ( uint8_t i = 0 ; i < tilecount ; i++ ) {
+
+            if ( addresses[ i ] > PIMORONI_11X7MATRIX_FRAME_LAST_REG ) { continue; }
+
+            uint8_t status = _tiles[ i ]->_frameImageRunWrite( framenumber , &addresses[ i ] , &masks[ i ] , NULL );
+
+            // we can't tell what made it, so this board sends it all again next time.  the others carry on.
+            if ( status ) {
+
+                _tiles[ i ]->_frameImageDirtyReturn( framenumber , &masks[ i ] );
+                addresses[ i ] = PIMORONI_11X7MATRIX_FRAME_LAST_REG + 1;
+
+                if ( !firststatus ) { firststatus = status; }
+                continue;
+
+            }
+
+            if ( addresses[ i ] <= PIMORONI_11X7MATRIX_FRAME_LAST_REG ) { busy = 1; }
+
+        }
+
+    }
+
+    return firststatus;
+
+}
+
+
+/// @brief Show a frame on every board, one write each, back to back.
+/// @param framenumber The number of the frame to display. 0-7.
+/// @return PIMORONI_11X7MATRIX_OK, or the first error a board hit.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixCanvasT< Transport >::frameDisplayPointerSet( uint8_t framenumber ) {
+
+    uint8_t firststatus = PIMORONI_11X7MATRIX_OK;
+
+    for ( uint8_t i = 0 ; i < _tileswide * _tileshigh ; i++ ) {
+
+        if ( !_tiles[ i ] ) { continue; }
+
+        uint8_t status = _tiles[ i ]->frameDisplayPointerSet( framenumber );
+        if ( status && !firststatus ) { firststatus = status; }
+
+    }
+
+    return firststatus;
+
+}
+
+
+
+
+/// @brief Sets the pixel buffers of every board for state, blink and pwm to all zero.
+template< class Transport >
+void Pimoroni_11x7matrixCanvasT< Transport >::pixelBufferClearAll() {
+
+    for ( uint8_t i = 0 ; i < _tileswide * _tileshigh ; i++ ) {
+
+        if ( _tiles[ i ] ) { _tiles[ i ]->pixelBufferClearAll(); }
+
+    }
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+/// @brief Sets a pixel to on or off.
+/// @param xpos The x position, with zero at the bottom left of the canvas.
+/// @param ypos The y position, with zero at the bottom left of the canvas.
+/// @param state The state, 1 for on, 0 for off.
+template< class Transport >
+void Pimoroni_11x7matrixCanvasT< Transport >::pixelSet( uint8_t xpos , uint8_t ypos , uint8_t state ) {
+
+    Pimoroni_11x7matrixT< Transport > *tile = _tileFind( &xpos , &ypos );
+
+    if ( tile ) { tile->pixelSet( xpos , ypos , state ); }
+
+}
+
+
+/// @brief Gets the state of a pixel.
+/// @param xpos The x position, with zero at the bottom left of the canvas.
+/// @param ypos The y position, with zero at the bottom left of the canvas.
+/// @return 0 for off, 1 for on.  0 off the canvas.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixCanvasT< Transport >::pixelGet( uint8_t xpos , uint8_t ypos ) {
+
+    Pimoroni_11x7matrixT< Transport > *tile = _tileFind( &xpos , &ypos );
+
+    return tile ? tile->pixelGet( xpos , ypos ) : 0;
+
+}
+
+
+/// @brief Set the blink flag for a pixel on or off.
+/// @param xpos The x position, with zero at the bottom left of the canvas.
+/// @param ypos The y position, with zero at the bottom left of the canvas.
+/// @param state 0 for off, 1 for on.
+template< class Transport >
+void Pimoroni_11x7matrixCanvasT< Transport >::pixelBlinkSet( uint8_t xpos , uint8_t ypos , uint8_t state ) {
+
+    Pimoroni_11x7matrixT< Transport > *tile = _tileFind( &xpos , &ypos );
+
+    if ( tile ) { tile->pixelBlinkSet( xpos , ypos , state ); }
+
+}
+
+
+/// @brief Gets the blink flag of a pixel.
+/// @param xpos The x position, with zero at the bottom left of the canvas.
+/// @param ypos The y position, with zero at the bottom left of the canvas.
+/// @return 0 for off, 1 for on.  0 off the canvas.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixCanvasT< Transport >::pixelBlinkGet( uint8_t xpos , uint8_t ypos ) {
+
+    Pimoroni_11x7matrixT< Transport > *tile = _tileFind( &xpos , &ypos );
+
+    return tile ? tile->pixelBlinkGet( xpos , ypos ) : 0;
+
+}
+
+
+/// @brief Set the pwm value for a pixel.
+/// @param xpos The x position, with zero at the bottom left of the canvas.
+/// @param ypos The y position, with zero at the bottom left of the canvas.
+/// @param state 0 is full off, 255 is full on.
+template< class Transport >
+void Pimoroni_11x7matrixCanvasT< Transport >::pixelpwmSet( uint8_t xpos , uint8_t ypos , uint8_t state ) {
+
+    Pimoroni_11x7matrixT< Transport > *tile = _tileFind( &xpos , &ypos );
+
+    if ( tile ) { tile->pixelpwmSet( xpos , ypos , state ); }
+
+}
+
+
+/// @brief Gets the pwm value for a pixel.
+/// @param xpos The x position, with zero at the bottom left of the canvas.
+/// @param ypos The y position, with zero at the bottom left of the canvas.
+/// @return 0 is full off, 255 is full on.  0 off the canvas.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixCanvasT< Transport >::pixelpwmGet( uint8_t xpos , uint8_t ypos ) {
+
+    Pimoroni_11x7matrixT< Transport > *tile = _tileFind( &xpos , &ypos );
+
+    return tile ? tile->pixelpwmGet( xpos , ypos ) : 0;
+
+}
+
+
+
+
+#endif
@@ -0,0 +1,11 @@
+// include my header
+#include <pimoroni_11x7matrix_draw.h>
+
+// and the implementation
+#include <pimoroni_11x7matrix_draw_impl.h>
+
+
+
+
+// build the drawing primitives for the usual Wire bus
+template class Pimoroni_11x7matrixDrawT< Pimoroni_11x7matrixWireTransport >;
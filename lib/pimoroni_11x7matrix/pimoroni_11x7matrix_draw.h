@@ -0,0 +1,170 @@
+#ifndef PIMORONI_11X7MATRIX_DRAW_HEADER_GUARD
+#define PIMORONI_11X7MATRIX_DRAW_HEADER_GUARD
+
+
+// drawing primitives for the 11x7 matrix board by pimoroni, a whole column at a time
+
+// pull in the matrix driver
+#include <pimoroni_11x7matrix.h>
+
+
+// how a shape is combined with what is already there, for the pixels the shape covers.
+// set copies the shape in, or adds its on pixels, and keeps only its on pixels, xor toggles them, and clear turns them off.
+// lines and rectangles are all on pixels, so set and or draw them, xor inverts them, and clear rubs them out.
+#define PIMORONI_11X7MATRIX_DRAW_SET 0
+#define PIMORONI_11X7MATRIX_DRAW_OR 1
+#define PIMORONI_11X7MATRIX_DRAW_AND 2
+#define PIMORONI_11X7MATRIX_DRAW_XOR 3
+#define PIMORONI_11X7MATRIX_DRAW_CLEAR 4
+
+
+
+
+/// @brief Draws lines, rectangles, columns and rows into a matrix's pixel buffers.
+/// Use Pimoroni_11x7matrixDraw with the usual Pimoroni_11x7matrix.
+/// Each shape is worked out as a mask per column first, then every column it covers is written once,
+/// so a rectangle is at most 11 buffer writes however big it is.  Masks have bit 0 at the bottom, bit 6 at the top.
+/// Shapes cover the pixels they pass through, and the blend mode says what happens to those, nothing else is touched.
+/// Anything off the board is clipped.  The matrix's orientation is followed, and so is brightness only mode.
+/// Send the result with the matrix's usual write functions.
+template< class Transport >
+class Pimoroni_11x7matrixDrawT {
+
+
+    private:
+
+    /// @brief The matrix to draw into.
+    Pimoroni_11x7matrixT< Transport > *_matrix;
+
+    /// @brief The blend mode, one of the PIMORONI_11X7MATRIX_DRAW values.
+    uint8_t _mode;
+
+    /// @brief The pixel buffers to draw into, PIMORONI_11X7MATRIX_BUFFER_STATE and or PIMORONI_11X7MATRIX_BUFFER_BLINK.
+    uint8_t _buffers;
+
+    /// @brief Combine the rows a shape covers in a column with the shape, by the blend mode.
+    /// @param dest The column as it is.
+    /// @param cover The rows the shape covers.
+    /// @param pattern Which of those rows are on in the shape.
+    /// @return The new column.
+    uint8_t _blend( uint8_t dest , uint8_t cover , uint8_t pattern );
+
+    /// @brief Combine one column with a shape, and store it if it changed.
+    /// @param xpos The x position of the column.
+    /// @param cover The rows the shape covers in this column.
+    /// @param pattern Which of those rows are on in the shape.
+    void _columnApply( uint8_t xpos , uint8_t cover , uint8_t pattern );
+
+    /// @brief Set the pwm value of the rows a shape covers in one column.
+    /// @param xpos The x position of the column.
+    /// @param cover The rows the shape covers in this column.
+    /// @param value The pwm value.
+    void _columnpwmApply( uint8_t xpos , uint8_t cover , uint8_t value );
+
+    /// @brief Works out which rows a line passes through in each column, bresenham's way.
+    /// @param x0 The x position of one end.
+    /// @param y0 The y position of one end.
+    /// @param x1 The x position of the other end.
+    /// @param y1 The y position of the other end.
+    /// @param masks Or'd with the rows in each of the 11 columns.
+    void _lineMasks( uint8_t x0 , uint8_t y0 , uint8_t x1 , uint8_t y1 , uint8_t *masks );
+
+
+
+    public:
+
+    /// @brief Constructor for the drawing primitives.
+    /// @param matrix The matrix to draw into.
+    Pimoroni_11x7matrixDrawT( Pimoroni_11x7matrixT< Transport > &matrix );
+
+
+    /// @brief Set how shapes are combined with what is already there.
+    /// @param mode One of the PIMORONI_11X7MATRIX_DRAW values.  PIMORONI_11X7MATRIX_DRAW_SET to start with.
+    void blendModeSet( uint8_t mode );
+
+    /// @brief Gets how shapes are combined with what is already there.
+    /// @return One of the PIMORONI_11X7MATRIX_DRAW values.
+    uint8_t blendModeGet();
+
+    /// @brief Set which pixel buffers the shapes are drawn into.
+    /// @param buffers PIMORONI_11X7MATRIX_BUFFER_STATE, PIMORONI_11X7MATRIX_BUFFER_BLINK, or both or'd together.  State to start with.
+    void bufferSet( uint8_t buffers );
+
+    /// @brief Gets which pixel buffers the shapes are drawn into.
+    /// @return PIMORONI_11X7MATRIX_BUFFER_STATE and or PIMORONI_11X7MATRIX_BUFFER_BLINK.
+    uint8_t bufferGet();
+
+
+
+
+    /// @brief Draw a whole column.
+    /// @param xpos The x position of the column.
+    /// @param mask The pixels that are on, bit 0 at the bottom.
+    void columnSet( uint8_t xpos , uint8_t mask );
+
+    /// @brief Draw a whole row.
+    /// @param ypos The y position of the row.
+    /// @param mask The pixels that are on, bit 0 on the left, bit 10 on the right.
+    void rowSet( uint8_t ypos , uint16_t mask );
+
+    /// @brief Draw a filled rectangle.
+    /// @param xpos The x position of the bottom left corner.
+    /// @param ypos The y position of the bottom left corner.
+    /// @param width The width in pixels.
+    /// @param height The height in pixels.
+    void fillRect( uint8_t xpos , uint8_t ypos , uint8_t width , uint8_t height );
+
+    /// @brief Draw a line, both ends included.
+    /// @param x0 The x position of one end.
+    /// @param y0 The y position of one end.
+    /// @param x1 The x position of the other end.
+    /// @param y1 The y position of the other end.
+    void line( uint8_t x0 , uint8_t y0 , uint8_t x1 , uint8_t y1 );
+
+
+
+
+    /// @brief Set the pwm value of the pixels in a column.  The blend mode does not apply.
+    /// @param xpos The x position of the column.
+    /// @param mask The pixels to set, bit 0 at the bottom.
+    /// @param value The pwm value.  0 is full off, 255 is full on.
+    void pwmColumnSet( uint8_t xpos , uint8_t mask , uint8_t value );
+
+    /// @brief Set the pwm value of the pixels in a row.  The blend mode does not apply.
+    /// @param ypos The y position of the row.
+    /// @param mask The pixels to set, bit 0 on the left, bit 10 on the right.
+    /// @param value The pwm value.  0 is full off, 255 is full on.
+    void pwmRowSet( uint8_t ypos , uint16_t mask , uint8_t value );
+
+    /// @brief Set the pwm value of every pixel in a rectangle.  The blend mode does not apply.
+    /// @param xpos The x position of the bottom left corner.
+    /// @param ypos The y position of the bottom left corner.
+    /// @param width The width in pixels.
+    /// @param height The height in pixels.
+    /// @param value The pwm value.  0 is full off, 255 is full on.
+    void pwmFillRect( uint8_t xpos , uint8_t ypos , uint8_t width , uint8_t height , uint8_t value );
+
+    /// @brief Set the pwm value of every pixel on a line, both ends included.  The blend mode does not apply.
+    /// @param x0 The x position of one end.
+    /// @param y0 The y position of one end.
+    /// @param x1 The x position of the other end.
+    /// @param y1 The y position of the other end.
+    /// @param value The pwm value.  0 is full off, 255 is full on.
+    void pwmLine( uint8_t x0 , uint8_t y0 , uint8_t x1 , uint8_t y1 , uint8_t value );
+
+
+};
+
+
+
+
+// the drawing primitives for the usual Wire bus, built once in pimoroni_11x7matrix_draw.cpp.
+extern template class Pimoroni_11x7matrixDrawT< Pimoroni_11x7matrixWireTransport >;
+typedef Pimoroni_11x7matrixDrawT< Pimoroni_11x7matrixWireTransport > Pimoroni_11x7matrixDraw;
+
+
+
+
+
+
+#endif
@@ -0,0 +1,363 @@
+#ifndef PIMORONI_11X7MATRIX_DRAW_IMPL_HEADER_GUARD
+#define PIMORONI_11X7MATRIX_DRAW_IMPL_HEADER_GUARD
+
+
+// implementation of the drawing primitives template.
+// pimoroni_11x7matrix_draw.cpp builds it for the default wire transport, include this yourself to build it for another transport.
+
+// include my header
+#include <pimoroni_11x7matrix_draw.h>
+
+
+
+
+/// @brief Constructor for the drawing primitives.
+/// @param matrix The matrix to draw into.
+template< class Transport >
+Pimoroni_11x7matrixDrawT< Transport >::Pimoroni_11x7matrixDrawT( Pimoroni_11x7matrixT< Transport > &matrix ) {
+
+    _matrix = &matrix;
+
+    _mode = PIMORONI_11X7MATRIX_DRAW_SET;
+    _buffers = PIMORONI_11X7MATRIX_BUFFER_STATE;
+
+}
+
+
+
+
+/// @brief Combine the rows a shape covers in a column with the shape, by the blend mode.
+/// @param dest The column as it is.
+/// @param cover The rows the shape covers.
+/// @param pattern Which of those rows are on in the shape.
+/// @return The new column.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixDrawT< Transport >::_blend( uint8_t dest , uint8_t cover , uint8_t pattern ) {
+
+    uint8_t result;
+
+    switch ( _mode ) {
+
+        case PIMORONI_11X7MATRIX_DRAW_OR: result = dest | pattern; break;
+        case PIMORONI_11X7MATRIX_DRAW_AND: result = dest & pattern; break;
+        case PIMORONI_11X7MATRIX_DRAW_XOR: result = dest ^ pattern; break;
+        case PIMORONI_11X7MATRIX_DRAW_CLEAR: result = dest & ~pattern; break;
+        default: result = pattern; break;
+
+    }
+
+    // only the rows the shape covers change
+    return ( dest & ~cover ) | ( result & cover );
+
+}
+
+
+/// @brief Combine one column with a shape, and store it if it changed.
+/// @param xpos The x position of the column.
+/// @param cover The rows the shape covers in this column.
+/// @param pattern Which of those rows are on in the shape.
+template< class Transport >
+void Pimoroni_11x7matrixDrawT< Transport >::_columnApply( uint8_t xpos , uint8_t cover , uint8_t pattern ) {
+
+    if ( xpos >= 11 ) { return; }
+
+    uint8_t chipindex = _matrix->_columnmap[ xpos ];
+
+    cover = _matrix->_columnMaskOrient( cover );
+    pattern = _matrix->_columnMaskOrient( pattern ) & cover;
+
+    // through the pwm in brightness only mode
+    if ( _buffers & PIMORONI_11X7MATRIX_BUFFER_STATE ) {
+
+        _matrix->_stateColumnSet( chipindex , _blend( _matrix->_stateColumnGet( chipindex ) , cover , pattern ) );
+
+    }
+
+    if ( _buffers & PIMORONI_11X7MATRIX_BUFFER_BLINK ) {
+
+        _matrix->_bitBufferColumnSet( _matrix->_ledblinkstate , _matrix->_ledblinkstatedirty , chipindex , _blend( _matrix->_ledblinkstate[ chipindex ] , cover , pattern ) );
+
+    }
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+/// @brief Set the pwm value of the rows a shape covers in one column.
+/// @param xpos The x position of the column.
+/// @param cover The rows the shape covers in this column.
+/// @param value The pwm value.
+template< class Transport >
+void Pimoroni_11x7matrixDrawT< Transport >::_columnpwmApply( uint8_t xpos , uint8_t cover , uint8_t value ) {
+
+    if ( xpos >= 11 ) { return; }
+
+    uint8_t chipindex = _matrix->_columnmap[ xpos ];
+
+    for ( uint8_t y = 0 ; y < 7 ; y++ ) {
+
+        if ( ( cover >> y ) & 0b00000001 ) { _matrix->_pwmBufferSet( chipindex , _matrix->_rowmap[ y ] , value ); }
+
+    }
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+/// @brief Works out which rows a line passes through in each column, bresenham's way.
+/// @param x0 The x position of one end.
+/// @param y0 The y position of one end.
+/// @param x1 The x position of the other end.
+/// @param y1 The y position of the other end.
+/// @param masks Or'd with the rows in each of the 11 columns.
+template< class Transport >
+void Pimoroni_11x7matrixDrawT< Transport >::_lineMasks( uint8_t x0 , uint8_t y0 , uint8_t x1 , uint8_t y1 , uint8_t *masks ) {
+
+    int16_t xpos = x0;
+    int16_t ypos = y0;
+
+    int16_t dx = ( x1 > x0 ) ? x1 - x0 : x0 - x1;
+    int16_t dy = ( y1 > y0 ) ? y0 - y1 : y1 - y0;
+    int8_t sx = ( x1 > x0 ) ? 1 : -1;
+    int8_t sy = ( y1 > y0 ) ? 1 : -1;
+    int16_t error = dx + dy;
+
+    while ( 1 ) {
+
+        // anything off the board is just not drawn
+        if ( ( xpos < 11 ) && ( ypos < 7 ) ) { masks[ xpos ] |= ( 0b00000001 << ypos ); }
+
+        if ( ( xpos == x1 ) && ( ypos == y1 ) ) { break; }
+
+        int16_t error2 = 2 * error;
+        if ( error2 >= dy ) { error += dy; xpos += sx; }
+        if ( error2 <= dx ) { error += dx; ypos += sy; }
+
+    }
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+
+
+/// @brief Set how shapes are combined with what is already there.
+/// @param mode One of the PIMORONI_11X7MATRIX_DRAW values.
+template< class Transport >
+void Pimoroni_11x7matrixDrawT< Transport >::blendModeSet( uint8_t mode ) {
+
+    _mode = mode;
+
+}
+
+
+/// @brief Gets how shapes are combined with what is already there.
+/// @return One of the PIMORONI_11X7MATRIX_DRAW values.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixDrawT< Transport >::blendModeGet() {
+
+    return _mode;
+
+}
+
+
+/// @brief Set which pixel buffers the shapes are drawn into.
+/// @param buffers PIMORONI_11X7MATRIX_BUFFER_STATE, PIMORONI_11X7MATRIX_BUFFER_BLINK, or both or'd together.
+template< class Transport >
+void Pimoroni_11x7matrixDrawT< Transport >::bufferSet( uint8_t buffers ) {
+
+    _buffers = buffers & ( PIMORONI_11X7MATRIX_BUFFER_STATE | PIMORONI_11X7MATRIX_BUFFER_BLINK );
+
+}
+
+
+/// @brief Gets which pixel buffers the shapes are drawn into.
+/// @return PIMORONI_11X7MATRIX_BUFFER_STATE and or PIMORONI_11X7MATRIX_BUFFER_BLINK.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixDrawT< Transport >::bufferGet() {
+
+    return _buffers;
+
+}
+
+
+
+
+/// @brief Draw a whole column.
+/// @param xpos The x position of the column.
+/// @param mask The pixels that are on, bit 0 at the bottom.
+template< class Transport >
+void Pimoroni_11x7matrixDrawT< Transport >::columnSet( uint8_t xpos , uint8_t mask ) {
+
+    _columnApply( xpos , 0b01111111 , mask );
+
+}
+
+
+/// @brief Draw a whole row.
+/// @param ypos The y position of the row.
+/// @param mask The pixels that are on, bit 0 on the left, bit 10 on the right.
+template< class Transport >
+void Pimoroni_11x7matrixDrawT< Transport >::rowSet( uint8_t ypos , uint16_t mask ) {
+
+    if ( ypos >= 7 ) { return; }
+
+    uint8_t row = ( 0b00000001 << ypos );
+
+    // one write per column, the row is one bit of each
+    for ( uint8_t x = 0 ; x < 11 ; x++ ) {
+
+        _columnApply( x , row , ( ( mask >> x ) & 0x0001 ) ? row : 0x00 );
+
+    }
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+/// @brief Draw a filled rectangle.
+/// @param xpos The x position of the bottom left corner.
+/// @param ypos The y position of the bottom left corner.
+/// @param width The width in pixels.
+/// @param height The height in pixels.
+template< class Transport >
+void Pimoroni_11x7matrixDrawT< Transport >::fillRect( uint8_t xpos , uint8_t ypos , uint8_t width , uint8_t height ) {
+
+    if ( ( xpos >= 11 ) || ( ypos >= 7 ) ) { return; }
+
+    // clip it to the board
+    if ( width > 11 - xpos ) { width = 11 - xpos; }
+    if ( height > 7 - ypos ) { height = 7 - ypos; }
+
+    // every column gets the same mask
+    uint8_t mask = ( ( 0b00000001 << height ) - 1 ) << ypos;
+
+    for ( uint8_t x = xpos ; x < xpos + width ; x++ ) { _columnApply( x , mask , mask ); }
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+/// @brief Draw a line, both ends included.
+/// @param x0 The x position of one end.
+/// @param y0 The y position of one end.
+/// @param x1 The x position of the other end.
+/// @param y1 The y position of the other end.
+template< class Transport >
+void Pimoroni_11x7matrixDrawT< Transport >::line( uint8_t x0 , uint8_t y0 , uint8_t x1 , uint8_t y1 ) {
+
+    uint8_t masks[ 11 ] = { 0 };
+
+    _lineMasks( x0 , y0 , x1 , y1 , masks );
+
+    // each column it passes through is written once, however many pixels it has there
+    for ( uint8_t x = 0 ; x < 11 ; x++ ) {
+
+        if ( masks[ x ] ) { _columnApply( x , masks[ x ] , masks[ x ] ); }
+
+    }
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+
+
+/// @brief Set the pwm value of the pixels in a column.
+/// @param xpos The x position of the column.
+/// @param mask The pixels to set, bit 0 at the bottom.
+/// @param value The pwm value.  0 is full off, 255 is full on.
+template< class Transport >
+void Pimoroni_11x7matrixDrawT< Transport >::pwmColumnSet( uint8_t xpos , uint8_t mask , uint8_t value ) {
+
+    _columnpwmApply( xpos , mask , value );
+
+}
+
+
+/// @brief Set the pwm value of the pixels in a row.
+/// @param ypos The y position of the row.
+/// @param mask The pixels to set, bit 0 on the left, bit 10 on the right.
+/// @param value The pwm value.  0 is full off, 255 is full on.
+template< class Transport >
+void Pimoroni_11x7matrixDrawT< Transport >::pwmRowSet( uint8_t ypos , uint16_t mask , uint8_t value ) {
+
+    if ( ypos >= 7 ) { return; }
+
+    for ( uint8_t x = 0 ; x < 11 ; x++ ) {
+
+        if ( ( mask >> x ) & 0x0001 ) { _columnpwmApply( x , 0b00000001 << ypos , value ); }
+
+    }
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+/// @brief Set the pwm value of every pixel in a rectangle.
+/// @param xpos The x position of the bottom left corner.
+/// @param ypos The y position of the bottom left corner.
+/// @param width The width in pixels.
+/// @param height The height in pixels.
+/// @param value The pwm value.  0 is full off, 255 is full on.
+template< class Transport >
+void Pimoroni_11x7matrixDrawT< Transport >::pwmFillRect( uint8_t xpos , uint8_t ypos , uint8_t width , uint8_t height , uint8_t value ) {
+
+    if ( ( xpos >= 11 ) || ( ypos >= 7 ) ) { return; }
+
+    // clip it to the board
+    if ( width > 11 - xpos ) { width = 11 - xpos; }
+    if ( height > 7 - ypos ) { height = 7 - ypos; }
+
+    uint8_t mask = ( ( 0b00000001 << height ) - 1 ) << ypos;
+
+    for ( uint8_t x = xpos ; x < xpos + width ; x++ ) { _columnpwmApply( x , mask , value ); }
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+/// @brief Set the pwm value of every pixel on a line, both ends included.
+/// @param x0 The x position of one end.
+/// @param y0 The y position of one end.
+/// @param x1 The x position of the other end.
+/// @param y1 The y position of the other end.
+/// @param value The pwm value.  0 is full off, 255 is full on.
+template< class Transport >
+void Pimoroni_11x7matrixDrawT< Transport >::pwmLine( uint8_t x0 , uint8_t y0 , uint8_t x1 , uint8_t y1 , uint8_t value ) {
+
+    uint8_t masks[ 11 ] = { 0 };
+
+    _lineMasks( x0 , y0 , x1 , y1 , masks );
+
+    for ( uint8_t x = 0 ; x < 11 ; x++ ) {
+
+        if ( masks[ x ] ) { _columnpwmApply( x , masks[ x ] , value ); }
+
+    }
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+
+
+#endif
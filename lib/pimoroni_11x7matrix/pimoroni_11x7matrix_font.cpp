@@ -0,0 +1,337 @@
+// include my header
+#include <pimoroni_11x7matrix_font.h>
+
+
+
+
+// the glyph tables, one byte per column, left to right.
+// each font below is only linked in if something refers to it.
+
+// 5x7, bit 0 at the bottom.
+static const uint8_t pimoroni_11x7matrixFont5x7Columns[ 95 * 5 ] PROGMEM = {
+    0x00 , 0x00 , 0x00 , 0x00 , 0x00 ,  // space
+    0x00 , 0x00 , 0x7D , 0x00 , 0x00 ,  // !
+    0x00 , 0x70 , 0x00 , 0x70 , 0x00 ,  // "
+    0x14 , 0x7F , 0x14 , 0x7F , 0x14 ,  // #
+    0x12 , 0x2A , 0x7F , 0x2A , 0x24 ,  // $
+    0x62 , 0x64 , 0x08 , 0x13 , 0x23 ,  // %
+    0x36 , 0x49 , 0x55 , 0x22 , 0x05 ,  // &
+    0x00 , 0x50 , 0x60 , 0x00 , 0x00 ,  // '
+    0x00 , 0x1C , 0x22 , 0x41 , 0x00 ,  // (
+    0x00 , 0x41 , 0x22 , 0x1C , 0x00 ,  // )
+    0x14 , 0x08 , 0x3E , 0x08 , 0x14 ,  // *
+    0x08 , 0x08 , 0x3E , 0x08 , 0x08 ,  // +
+    0x00 , 0x05 , 0x06 , 0x00 , 0x00 ,  // ,
+    0x08 , 0x08 , 0x08 , 0x08 , 0x08 ,  // -
+    0x00 , 0x03 , 0x03 , 0x00 , 0x00 ,  // .
+    0x02 , 0x04 , 0x08 , 0x10 , 0x20 ,  // /
+    0x3E , 0x45 , 0x49 , 0x51 , 0x3E ,  // 0
+    0x00 , 0x21 , 0x7F , 0x01 , 0x00 ,  // 1
+    0x21 , 0x43 , 0x45 , 0x49 , 0x31 ,  // 2
+    0x42 , 0x41 , 0x51 , 0x69 , 0x46 ,  // 3
+    0x0C , 0x14 , 0x24 , 0x7F , 0x04 ,  // 4
+    0x72 , 0x51 , 0x51 , 0x51 , 0x4E ,  // 5
+    0x1E , 0x29 , 0x49 , 0x49 , 0x06 ,  // 6
+    0x40 , 0x47 , 0x48 , 0x50 , 0x60 ,  // 7
+    0x36 , 0x49 , 0x49 , 0x49 , 0x36 ,  // 8
+    0x30 , 0x49 , 0x49 , 0x4A , 0x3C ,  // 9
+    0x00 , 0x36 , 0x36 , 0x00 , 0x00 ,  // :
+    0x00 , 0x35 , 0x36 , 0x00 , 0x00 ,  // ;
+    0x08 , 0x14 , 0x22 , 0x41 , 0x00 ,  // <
+    0x14 , 0x14 , 0x14 , 0x14 , 0x14 ,  // =
+    0x00 , 0x41 , 0x22 , 0x14 , 0x08 ,  // >
+    0x20 , 0x40 , 0x45 , 0x48 , 0x30 ,  // ?
+    0x26 , 0x49 , 0x4F , 0x41 , 0x3E ,  // @
+    0x3F , 0x44 , 0x44 , 0x44 , 0x3F ,  // A
+    0x7F , 0x49 , 0x49 , 0x49 , 0x36 ,  // B
+    0x3E , 0x41 , 0x41 , 0x41 , 0x22 ,  // C
+    0x7F , 0x41 , 0x41 , 0x22 , 0x1C ,  // D
+    0x7F , 0x49 , 0x49 , 0x49 , 0x41 ,  // E
+    0x7F , 0x48 , 0x48 , 0x48 , 0x40 ,  // F
+    0x3E , 0x41 , 0x49 , 0x49 , 0x2F ,  // G
+    0x7F , 0x08 , 0x08 , 0x08 , 0x7F ,  // H
+    0x00 , 0x41 , 0x7F , 0x41 , 0x00 ,  // I
+    0x02 , 0x01 , 0x41 , 0x7E , 0x40 ,  // J
+    0x7F , 0x08 , 0x14 , 0x22 , 0x41 ,  // K
+    0x7F , 0x01 , 0x01 , 0x01 , 0x01 ,  // L
+    0x7F , 0x20 , 0x18 , 0x20 , 0x7F ,  // M
+    0x7F , 0x10 , 0x08 , 0x04 , 0x7F ,  // N
+    0x3E , 0x41 , 0x41 , 0x41 , 0x3E ,  // O
+    0x7F , 0x48 , 0x48 , 0x48 , 0x30 ,  // P
+    0x3E , 0x41 , 0x45 , 0x42 , 0x3D ,  // Q
+    0x7F , 0x48 , 0x4C , 0x4A , 0x31 ,  // R
+    0x31 , 0x49 , 0x49 , 0x49 , 0x46 ,  // S
+    0x40 , 0x40 , 0x7F , 0x40 , 0x40 ,  // T
+    0x7E , 0x01 , 0x01 , 0x01 , 0x7E ,  // U
+    0x7C , 0x02 , 0x01 , 0x02 , 0x7C ,  // V
+    0x7E , 0x01 , 0x0E , 0x01 , 0x7E ,  // W
+    0x63 , 0x14 , 0x08 , 0x14 , 0x63 ,  // X
+    0x70 , 0x08 , 0x07 , 0x08 , 0x70 ,  // Y
+    0x43 , 0x45 , 0x49 , 0x51 , 0x61 ,  // Z
+    0x00 , 0x7F , 0x41 , 0x41 , 0x00 ,  // [
+    0x20 , 0x10 , 0x08 , 0x04 , 0x02 ,  // backslash
+    0x00 , 0x41 , 0x41 , 0x7F , 0x00 ,  // ]
+    0x10 , 0x20 , 0x40 , 0x20 , 0x10 ,  // ^
+    0x01 , 0x01 , 0x01 , 0x01 , 0x01 ,  // _
+    0x00 , 0x40 , 0x20 , 0x10 , 0x00 ,  // `
+    0x02 , 0x15 , 0x15 , 0x15 , 0x0F ,  // a
+    0x7F , 0x09 , 0x11 , 0x11 , 0x0E ,  // b
+    0x0E , 0x11 , 0x11 , 0x11 , 0x02 ,  // c
+    0x0E , 0x11 , 0x11 , 0x09 , 0x7F ,  // d
+    0x0E , 0x15 , 0x15 , 0x15 , 0x0C ,  // e
+    0x08 , 0x3F , 0x48 , 0x40 , 0x20 ,  // f
+    0x18 , 0x25 , 0x25 , 0x25 , 0x3E ,  // g
+    0x7F , 0x08 , 0x10 , 0x10 , 0x0F ,  // h
+    0x00 , 0x11 , 0x5F , 0x01 , 0x00 ,  // i
+    0x02 , 0x01 , 0x11 , 0x5E , 0x00 ,  // j
+    0x7F , 0x04 , 0x0A , 0x11 , 0x00 ,  // k
+    0x00 , 0x41 , 0x7F , 0x01 , 0x00 ,  // l
+    0x1F , 0x10 , 0x0C , 0x10 , 0x0F ,  // m
+    0x1F , 0x08 , 0x10 , 0x10 , 0x0F ,  // n
+    0x0E , 0x11 , 0x11 , 0x11 , 0x0E ,  // o
+    0x1F , 0x14 , 0x14 , 0x14 , 0x08 ,  // p
+    0x08 , 0x14 , 0x14 , 0x0C , 0x1F ,  // q
+    0x1F , 0x08 , 0x10 , 0x10 , 0x08 ,  // r
+    0x09 , 0x15 , 0x15 , 0x15 , 0x02 ,  // s
+    0x10 , 0x7E , 0x11 , 0x01 , 0x02 ,  // t
+    0x1E , 0x01 , 0x01 , 0x02 , 0x1F ,  // u
+    0x1C , 0x02 , 0x01 , 0x02 , 0x1C ,  // v
+    0x1E , 0x01 , 0x06 , 0x01 , 0x1E ,  // w
+    0x11 , 0x0A , 0x04 , 0x0A , 0x11 ,  // x
+    0x18 , 0x05 , 0x05 , 0x05 , 0x1E ,  // y
+    0x11 , 0x13 , 0x15 , 0x19 , 0x11 ,  // z
+    0x00 , 0x08 , 0x36 , 0x41 , 0x00 ,  // {
+    0x00 , 0x00 , 0x7F , 0x00 , 0x00 ,  // |
+    0x00 , 0x41 , 0x36 , 0x08 , 0x00 ,  // }
+    0x08 , 0x10 , 0x08 , 0x04 , 0x08    // ~
+};
+
+
+// 3x5, bit 0 at the bottom.
+static const uint8_t pimoroni_11x7matrixFont3x5Columns[ 95 * 3 ] PROGMEM = {
+    0x00 , 0x00 , 0x00 ,  // space
+    0x00 , 0x1D , 0x00 ,  // !
+    0x18 , 0x00 , 0x18 ,  // "
+    0x1F , 0x0A , 0x1F ,  // #
+    0x09 , 0x1F , 0x12 ,  // $
+    0x13 , 0x04 , 0x19 ,  // %
+    0x0A , 0x15 , 0x0B ,  // &
+    0x00 , 0x18 , 0x00 ,  // '
+    0x00 , 0x0E , 0x11 ,  // (
+    0x11 , 0x0E , 0x00 ,  // )
+    0x0A , 0x04 , 0x0A ,  // *
+    0x04 , 0x0E , 0x04 ,  // +
+    0x01 , 0x02 , 0x00 ,  // ,
+    0x04 , 0x04 , 0x04 ,  // -
+    0x00 , 0x01 , 0x00 ,  // .
+    0x03 , 0x04 , 0x18 ,  // /
+    0x1F , 0x11 , 0x1F ,  // 0
+    0x09 , 0x1F , 0x01 ,  // 1
+    0x13 , 0x15 , 0x09 ,  // 2
+    0x11 , 0x15 , 0x0A ,  // 3
+    0x1C , 0x04 , 0x1F ,  // 4
+    0x1D , 0x15 , 0x12 ,  // 5
+    0x0F , 0x15 , 0x17 ,  // 6
+    0x10 , 0x17 , 0x18 ,  // 7
+    0x1F , 0x15 , 0x1F ,  // 8
+    0x1D , 0x15 , 0x1E ,  // 9
+    0x00 , 0x0A , 0x00 ,  // :
+    0x01 , 0x0A , 0x00 ,  // ;
+    0x04 , 0x0A , 0x11 ,  // <
+    0x0A , 0x0A , 0x0A ,  // =
+    0x11 , 0x0A , 0x04 ,  // >
+    0x10 , 0x15 , 0x08 ,  // ?
+    0x0E , 0x15 , 0x0D ,  // @
+    0x0F , 0x14 , 0x0F ,  // A
+    0x1F , 0x15 , 0x0A ,  // B
+    0x0E , 0x11 , 0x11 ,  // C
+    0x1F , 0x11 , 0x0E ,  // D
+    0x1F , 0x15 , 0x11 ,  // E
+    0x1F , 0x14 , 0x10 ,  // F
+    0x0E , 0x11 , 0x17 ,  // G
+    0x1F , 0x04 , 0x1F ,  // H
+    0x11 , 0x1F , 0x11 ,  // I
+    0x02 , 0x01 , 0x1E ,  // J
+    0x1F , 0x04 , 0x1B ,  // K
+    0x1F , 0x01 , 0x01 ,  // L
+    0x1F , 0x0C , 0x1F ,  // M
+    0x1F , 0x10 , 0x0F ,  // N
+    0x0E , 0x11 , 0x0E ,  // O
+    0x1F , 0x14 , 0x08 ,  // P
+    0x0E , 0x13 , 0x0F ,  // Q
+    0x1F , 0x14 , 0x0B ,  // R
+    0x09 , 0x15 , 0x12 ,  // S
+    0x10 , 0x1F , 0x10 ,  // T
+    0x1F , 0x01 , 0x1F ,  // U
+    0x1C , 0x03 , 0x1C ,  // V
+    0x1F , 0x06 , 0x1F ,  // W
+    0x1B , 0x04 , 0x1B ,  // X
+    0x18 , 0x07 , 0x18 ,  // Y
+    0x13 , 0x15 , 0x19 ,  // Z
+    0x1F , 0x11 , 0x00 ,  // [
+    0x18 , 0x04 , 0x03 ,  // backslash
+    0x00 , 0x11 , 0x1F ,  // ]
+    0x08 , 0x10 , 0x08 ,  // ^
+    0x01 , 0x01 , 0x01 ,  // _
+    0x10 , 0x08 , 0x00 ,  // `
+    0x06 , 0x09 , 0x0F ,  // a
+    0x1F , 0x09 , 0x06 ,  // b
+    0x06 , 0x09 , 0x09 ,  // c
+    0x06 , 0x09 , 0x1F ,  // d
+    0x06 , 0x0D , 0x0D ,  // e
+    0x04 , 0x0F , 0x14 ,  // f
+    0x05 , 0x0B , 0x0E ,  // g
+    0x1F , 0x08 , 0x07 ,  // h
+    0x00 , 0x17 , 0x00 ,  // i
+    0x02 , 0x01 , 0x16 ,  // j
+    0x1F , 0x04 , 0x0B ,  // k
+    0x11 , 0x1F , 0x01 ,  // l
+    0x0F , 0x0C , 0x0F ,  // m
+    0x0F , 0x08 , 0x07 ,  // n
+    0x06 , 0x09 , 0x06 ,  // o
+    0x0F , 0x0A , 0x04 ,  // p
+    0x04 , 0x0A , 0x0F ,  // q
+    0x07 , 0x08 , 0x08 ,  // r
+    0x05 , 0x0F , 0x0A ,  // s
+    0x08 , 0x1E , 0x09 ,  // t
+    0x0E , 0x01 , 0x0F ,  // u
+    0x0E , 0x01 , 0x0E ,  // v
+    0x0F , 0x03 , 0x0F ,  // w
+    0x09 , 0x06 , 0x09 ,  // x
+    0x0D , 0x03 , 0x0E ,  // y
+    0x0B , 0x0D , 0x0D ,  // z
+    0x04 , 0x1B , 0x11 ,  // {
+    0x00 , 0x1F , 0x00 ,  // |
+    0x11 , 0x1B , 0x04 ,  // }
+    0x04 , 0x0C , 0x08    // ~
+};
+
+
+// the 5x7 glyphs with their blank columns trimmed off, space is 2 wide.
+static const uint8_t pimoroni_11x7matrixFontVariableColumns[ 421 ] PROGMEM = {
+    0x00 , 0x00 ,  // space
+    0x7D ,  // !
+    0x70 , 0x00 , 0x70 ,  // "
+    0x14 , 0x7F , 0x14 , 0x7F , 0x14 ,  // #
+    0x12 , 0x2A , 0x7F , 0x2A , 0x24 ,  // $
+    0x62 , 0x64 , 0x08 , 0x13 , 0x23 ,  // %
+    0x36 , 0x49 , 0x55 , 0x22 , 0x05 ,  // &
+    0x50 , 0x60 ,  // '
+    0x1C , 0x22 , 0x41 ,  // (
+    0x41 , 0x22 , 0x1C ,  // )
+    0x14 , 0x08 , 0x3E , 0x08 , 0x14 ,  // *
+    0x08 , 0x08 , 0x3E , 0x08 , 0x08 ,  // +
+    0x05 , 0x06 ,  // ,
+    0x08 , 0x08 , 0x08 , 0x08 , 0x08 ,  // -
+    0x03 , 0x03 ,  // .
+    0x02 , 0x04 , 0x08 , 0x10 , 0x20 ,  // /
+    0x3E , 0x45 , 0x49 , 0x51 , 0x3E ,  // 0
+    0x21 , 0x7F , 0x01 ,  // 1
+    0x21 , 0x43 , 0x45 , 0x49 , 0x31 ,  // 2
+    0x42 , 0x41 , 0x51 , 0x69 , 0x46 ,  // 3
+    0x0C , 0x14 , 0x24 , 0x7F , 0x04 ,  // 4
+    0x72 , 0x51 , 0x51 , 0x51 , 0x4E ,  // 5
+    0x1E , 0x29 , 0x49 , 0x49 , 0x06 ,  // 6
+    0x40 , 0x47 , 0x48 , 0x50 , 0x60 ,  // 7
+    0x36 , 0x49 , 0x49 , 0x49 , 0x36 ,  // 8
+    0x30 , 0x49 , 0x49 , 0x4A , 0x3C ,  // 9
+    0x36 , 0x36 ,  // :
+    0x35 , 0x36 ,  // ;
+    0x08 , 0x14 , 0x22 , 0x41 ,  // <
+    0x14 , 0x14 , 0x14 , 0x14 , 0x14 ,  // =
+    0x41 , 0x22 , 0x14 , 0x08 ,  // >
+    0x20 , 0x40 , 0x45 , 0x48 , 0x30 ,  // ?
+    0x26 , 0x49 , 0x4F , 0x41 , 0x3E ,  // @
+    0x3F , 0x44 , 0x44 , 0x44 , 0x3F ,  // A
+    0x7F , 0x49 , 0x49 , 0x49 , 0x36 ,  // B
+    0x3E , 0x41 , 0x41 , 0x41 , 0x22 ,  // C
+    0x7F , 0x41 , 0x41 , 0x22 , 0x1C ,  // D
+    0x7F , 0x49 , 0x49 , 0x49 , 0x41 ,  // E
+    0x7F , 0x48 , 0x48 , 0x48 , 0x40 ,  // F
+    0x3E , 0x41 , 0x49 , 0x49 , 0x2F ,  // G
+    0x7F , 0x08 , 0x08 , 0x08 , 0x7F ,  // H
+    0x41 , 0x7F , 0x41 ,  // I
+    0x02 , 0x01 , 0x41 , 0x7E , 0x40 ,  // J
+    0x7F , 0x08 , 0x14 , 0x22 , 0x41 ,  // K
+    0x7F , 0x01 , 0x01 , 0x01 , 0x01 ,  // L
+    0x7F , 0x20 , 0x18 , 0x20 , 0x7F ,  // M
+    0x7F , 0x10 , 0x08 , 0x04 , 0x7F ,  // N
+    0x3E , 0x41 , 0x41 , 0x41 , 0x3E ,  // O
+    0x7F , 0x48 , 0x48 , 0x48 , 0x30 ,  // P
+    0x3E , 0x41 , 0x45 , 0x42 , 0x3D ,  // Q
+    0x7F , 0x48 , 0x4C , 0x4A , 0x31 ,  // R
+    0x31 , 0x49 , 0x49 , 0x49 , 0x46 ,  // S
+    0x40 , 0x40 , 0x7F , 0x40 , 0x40 ,  // T
+    0x7E , 0x01 , 0x01 , 0x01 , 0x7E ,  // U
+    0x7C , 0x02 , 0x01 , 0x02 , 0x7C ,  // V
+    0x7E , 0x01 , 0x0E , 0x01 , 0x7E ,  // W
+    0x63 , 0x14 , 0x08 , 0x14 , 0x63 ,  // X
+    0x70 , 0x08 , 0x07 , 0x08 , 0x70 ,  // Y
+    0x43 , 0x45 , 0x49 , 0x51 , 0x61 ,  // Z
+    0x7F , 0x41 , 0x41 ,  // [
+    0x20 , 0x10 , 0x08 , 0x04 , 0x02 ,  // backslash
+    0x41 , 0x41 , 0x7F ,  // ]
+    0x10 , 0x20 , 0x40 , 0x20 , 0x10 ,  // ^
+    0x01 , 0x01 , 0x01 , 0x01 , 0x01 ,  // _
+    0x40 , 0x20 , 0x10 ,  // `
+    0x02 , 0x15 , 0x15 , 0x15 , 0x0F ,  // a
+    0x7F , 0x09 , 0x11 , 0x11 , 0x0E ,  // b
+    0x0E , 0x11 , 0x11 , 0x11 , 0x02 ,  // c
+    0x0E , 0x11 , 0x11 , 0x09 , 0x7F ,  // d
+    0x0E , 0x15 , 0x15 , 0x15 , 0x0C ,  // e
+    0x08 , 0x3F , 0x48 , 0x40 , 0x20 ,  // f
+    0x18 , 0x25 , 0x25 , 0x25 , 0x3E ,  // g
+    0x7F , 0x08 , 0x10 , 0x10 , 0x0F ,  // h
+    0x11 , 0x5F , 0x01 ,  // i
+    0x02 , 0x01 , 0x11 , 0x5E ,  // j
+    0x7F , 0x04 , 0x0A , 0x11 ,  // k
+    0x41 , 0x7F , 0x01 ,  // l
+    0x1F , 0x10 , 0x0C , 0x10 , 0x0F ,  // m
+    0x1F , 0x08 , 0x10 , 0x10 , 0x0F ,  // n
+    0x0E , 0x11 , 0x11 , 0x11 , 0x0E ,  // o
+    0x1F , 0x14 , 0x14 , 0x14 , 0x08 ,  // p
+    0x08 , 0x14 , 0x14 , 0x0C , 0x1F ,  // q
+    0x1F , 0x08 , 0x10 , 0x10 , 0x08 ,  // r
+    0x09 , 0x15 , 0x15 , 0x15 , 0x02 ,  // s
+    0x10 , 0x7E , 0x11 , 0x01 , 0x02 ,  // t
+    0x1E , 0x01 , 0x01 , 0x02 , 0x1F ,  // u
+    0x1C , 0x02 , 0x01 , 0x02 , 0x1C ,  // v
+    0x1E , 0x01 , 0x06 , 0x01 , 0x1E ,  // w
+    0x11 , 0x0A , 0x04 , 0x0A , 0x11 ,  // x
+    0x18 , 0x05 , 0x05 , 0x05 , 0x1E ,  // y
+    0x11 , 0x13 , 0x15 , 0x19 , 0x11 ,  // z
+    0x08 , 0x36 , 0x41 ,  // {
+    0x7F ,  // |
+    0x41 , 0x36 , 0x08 ,  // }
+    0x08 , 0x10 , 0x08 , 0x04 , 0x08  // ~
+};
+
+// how many columns each glyph has
+static const uint8_t pimoroni_11x7matrixFontVariableWidths[ 95 ] PROGMEM = {
+    2 , 1 , 3 , 5 , 5 , 5 , 5 , 2 , 3 , 3 , 5 , 5 , 2 , 5 , 2 , 5 ,
+    5 , 3 , 5 , 5 , 5 , 5 , 5 , 5 , 5 , 5 , 2 , 2 , 4 , 5 , 4 , 5 ,
+    5 , 5 , 5 , 5 , 5 , 5 , 5 , 5 , 5 , 3 , 5 , 5 , 5 , 5 , 5 , 5 ,
+    5 , 5 , 5 , 5 , 5 , 5 , 5 , 5 , 5 , 5 , 5 , 3 , 5 , 3 , 5 , 5 ,
+    3 , 5 , 5 , 5 , 5 , 5 , 5 , 5 , 5 , 3 , 4 , 4 , 3 , 5 , 5 , 5 ,
+    5 , 5 , 5 , 5 , 5 , 5 , 5 , 5 , 5 , 5 , 5 , 3 , 1 , 3 , 5
+};
+
+// where each glyph starts in the columns
+static const uint16_t pimoroni_11x7matrixFontVariableOffsets[ 95 ] PROGMEM = {
+      0 ,   2 ,   3 ,   6 ,  11 ,  16 ,  21 ,  26 ,  28 ,  31 ,  34 ,  39 ,  44 ,  46 ,  51 ,  53 ,
+     58 ,  63 ,  66 ,  71 ,  76 ,  81 ,  86 ,  91 ,  96 , 101 , 106 , 108 , 110 , 114 , 119 , 123 ,
+    128 , 133 , 138 , 143 , 148 , 153 , 158 , 163 , 168 , 173 , 176 , 181 , 186 , 191 , 196 , 201 ,
+    206 , 211 , 216 , 221 , 226 , 231 , 236 , 241 , 246 , 251 , 256 , 261 , 264 , 269 , 272 , 277 ,
+    282 , 285 , 290 , 295 , 300 , 305 , 310 , 315 , 320 , 325 , 328 , 332 , 336 , 339 , 344 , 349 ,
+    354 , 359 , 364 , 369 , 374 , 379 , 384 , 389 , 394 , 399 , 404 , 409 , 412 , 413 , 416
+};
+
+
+
+
+// the fonts themselves.
+const Pimoroni_11x7matrixFont pimoroni_11x7matrixFont5x7 = { 32 , 126 , 5 , 7 , 1 , pimoroni_11x7matrixFont5x7Columns , NULL , NULL };
+
+const Pimoroni_11x7matrixFont pimoroni_11x7matrixFont3x5 = { 32 , 126 , 3 , 5 , 1 , pimoroni_11x7matrixFont3x5Columns , NULL , NULL };
+
+const Pimoroni_11x7matrixFont pimoroni_11x7matrixFontVariable = { 32 , 126 , 0 , 7 , 1 , pimoroni_11x7matrixFontVariableColumns , pimoroni_11x7matrixFontVariableWidths , pimoroni_11x7matrixFontVariableOffsets };
@@ -0,0 +1,65 @@
+#ifndef PIMORONI_11X7MATRIX_FONT_HEADER_GUARD
+#define PIMORONI_11X7MATRIX_FONT_HEADER_GUARD
+
+
+// bitmap fonts for the 11x7 matrix board by pimoroni, kept in flash
+
+// pull in the arduino headers
+#include <Arduino.h>
+
+
+
+
+/// @brief A bitmap font, one byte per glyph column, bit 0 at the bottom, everything in PROGMEM.
+/// Glyphs run from first to last with nothing missing.  Fixed width fonts leave widths and offsets NULL,
+/// and glyph c starts at columns[ ( c - first ) * width ].  Variable width fonts keep each glyph's width in widths
+/// and where its columns start in offsets.  Use it with Pimoroni_11x7matrixText.
+struct Pimoroni_11x7matrixFont {
+
+    /// @brief The first character in the font.
+    uint8_t first;
+
+    /// @brief The last character in the font.
+    uint8_t last;
+
+    /// @brief The width of every glyph in columns, or 0 if they are all different.
+    uint8_t width;
+
+    /// @brief The height of the glyphs in rows, from the bottom of the column.
+    uint8_t height;
+
+    /// @brief Blank columns between glyphs.
+    uint8_t spacing;
+
+    /// @brief The glyph columns, in PROGMEM.
+    const uint8_t *columns;
+
+    /// @brief The width of each glyph, in PROGMEM.  NULL for fixed width fonts.
+    const uint8_t *widths;
+
+    /// @brief Where each glyph starts in columns, in PROGMEM.  NULL for fixed width fonts.
+    const uint16_t *offsets;
+
+};
+
+
+
+
+// the fonts that come with the library, in pimoroni_11x7matrix_font.cpp.
+// only the ones you use are linked in.
+
+// 5 columns by 7 rows, printable ascii, 475 bytes of glyphs.  fills the board's height.
+extern const Pimoroni_11x7matrixFont pimoroni_11x7matrixFont5x7;
+
+// 3 columns by 5 rows, printable ascii, 285 bytes of glyphs.  fits 3 characters across the board.
+extern const Pimoroni_11x7matrixFont pimoroni_11x7matrixFont3x5;
+
+// the 5x7 glyphs with their blank columns trimmed, 1 to 5 wide, 421 bytes of glyphs plus 285 of widths and offsets.
+extern const Pimoroni_11x7matrixFont pimoroni_11x7matrixFontVariable;
+
+
+
+
+
+
+#endif
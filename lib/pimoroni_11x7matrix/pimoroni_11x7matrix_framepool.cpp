@@ -0,0 +1,11 @@
+// include my header
+#include <pimoroni_11x7matrix_framepool.h>
+
+// and the implementation
+#include <pimoroni_11x7matrix_framepool_impl.h>
+
+
+
+
+// build the frame pool for the usual Wire bus
+template class Pimoroni_11x7matrixFramePoolT< Pimoroni_11x7matrixWireTransport >;
@@ -0,0 +1,128 @@
+#ifndef PIMORONI_11X7MATRIX_FRAMEPOOL_HEADER_GUARD
+#define PIMORONI_11X7MATRIX_FRAMEPOOL_HEADER_GUARD
+
+
+// hardware frame pool with a least recently used image cache, for the 11x7 matrix board by pimoroni
+
+// pull in the matrix driver
+#include <pimoroni_11x7matrix.h>
+
+
+
+
+/// @brief Keeps images resident in the chip's frames, so showing one again is a single display pointer write.
+/// Use Pimoroni_11x7matrixFramePool with the usual Pimoroni_11x7matrix.
+/// Images are known by a key, either your own id or pixelBufferHashGet() of what they look like.
+/// Draw the image into the pixel buffers only if resident() says it is not there, then show() it.
+/// A new image goes into the frame used least recently, and only the columns that differ from
+/// what that frame held are sent.  The frame showing is the one used most recently, so it is never drawn over
+/// while there are at least 2 frames in the pool.
+template< class Transport >
+class Pimoroni_11x7matrixFramePoolT {
+
+
+    private:
+
+    /// @brief The matrix the frames belong to.
+    Pimoroni_11x7matrixT< Transport > *_matrix;
+
+    /// @brief The first frame in the pool. 0-7.
+    uint8_t _firstframe;
+
+    /// @brief How many frames are in the pool. 1-8.
+    uint8_t _framecount;
+
+    /// @brief The key of the image in each frame.
+    uint32_t _keys[ 8 ];
+
+    /// @brief One bit per frame holding an image, bit 0 = _firstframe.
+    uint8_t _valid;
+
+    /// @brief How many show() calls since each frame was last shown, stops at 255.
+    uint8_t _age[ 8 ];
+
+    /// @brief show() calls that found the image resident.
+    uint32_t _hits;
+
+    /// @brief show() calls that had to upload the image.
+    uint32_t _misses;
+
+    /// @brief Finds the frame holding an image.
+    /// @param key The key of the image.
+    /// @return The index in the pool, or 0xFF if it is not resident.
+    uint8_t _find( uint32_t key );
+
+    /// @brief Picks the frame to put a new image in, an empty one if there is one, otherwise the least recently used.
+    /// @return The index in the pool.
+    uint8_t _victim();
+
+    /// @brief Marks a frame as the most recently used.
+    /// @param slot The index in the pool.
+    void _touch( uint8_t slot );
+
+
+
+    public:
+
+    /// @brief Constructor for the frame pool.
+    /// @param matrix The matrix the frames belong to.
+    /// @param firstframe The first frame the pool may use. 0-7.
+    /// @param framecount How many frames from there the pool may use. 1-8.  Leave the rest for anything else.
+    Pimoroni_11x7matrixFramePoolT( Pimoroni_11x7matrixT< Transport > &matrix , uint8_t firstframe = 0 , uint8_t framecount = 8 );
+
+
+    /// @brief Checks if an image is resident.  Does not count as using it.
+    /// @param key The key of the image.
+    /// @return 1 if it is in a frame, 0 if not.
+    uint8_t resident( uint32_t key );
+
+    /// @brief Show an image.
+    /// If it is resident this is a display pointer write, or nothing at all if it is already showing.
+    /// If not, the pixel buffers are uploaded into the least recently used frame first, so draw it before calling this.
+    /// @param key The key of the image.
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.  A failed upload leaves the image not resident.
+    uint8_t show( uint32_t key );
+
+    /// @brief Show whatever is in the pixel buffers, keyed by pixelBufferHashGet().
+    /// Draw as usual, and if the same picture has been shown recently it is not sent again.
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t showBuffer();
+
+    /// @brief Gets a hash of the pixel buffers, state, blink and pwm.
+    /// 32 bit fnv-1a, so two different pictures sharing a hash is possible but very unlikely.
+    /// @return The hash.
+    uint32_t pixelBufferHashGet();
+
+
+    /// @brief Forget one image, so the next show() of it uploads it again.
+    /// @param key The key of the image.
+    void invalidate( uint32_t key );
+
+    /// @brief Forget every image.  Use this if the frames have been written by anything else.
+    void clear();
+
+
+    /// @brief Gets how many show() calls found their image resident.
+    /// @return The count.
+    uint32_t hitCountGet();
+
+    /// @brief Gets how many show() calls had to upload their image.
+    /// @return The count.
+    uint32_t missCountGet();
+
+
+};
+
+
+
+
+// the frame pool for the usual Wire bus, built once in pimoroni_11x7matrix_framepool.cpp.
+extern template class Pimoroni_11x7matrixFramePoolT< Pimoroni_11x7matrixWireTransport >;
+typedef Pimoroni_11x7matrixFramePoolT< Pimoroni_11x7matrixWireTransport > Pimoroni_11x7matrixFramePool;
+
+
+
+
+
+
+#endif
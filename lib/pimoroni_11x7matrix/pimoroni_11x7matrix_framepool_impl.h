@@ -0,0 +1,239 @@
+#ifndef PIMORONI_11X7MATRIX_FRAMEPOOL_IMPL_HEADER_GUARD
+#define PIMORONI_11X7MATRIX_FRAMEPOOL_IMPL_HEADER_GUARD
+
+
+// implementation of the hardware frame pool template.
+// pimoroni_11x7matrix_framepool.cpp builds it for the default wire transport, include this yourself to build it for another transport.
+
+// include my header
+#include <pimoroni_11x7matrix_framepool.h>
+
+
+
+
+/// @brief Constructor for the frame pool.
+/// @param matrix The matrix the frames belong to.
+/// @param firstframe The first frame the pool may use. 0-7.
+/// @param framecount How many frames from there the pool may use. 1-8.
+template< class Transport >
+Pimoroni_11x7matrixFramePoolT< Transport >::Pimoroni_11x7matrixFramePoolT( Pimoroni_11x7matrixT< Transport > &matrix , uint8_t firstframe , uint8_t framecount ) {
+
+    _matrix = &matrix;
+
+    // keep inside the chip
+    _firstframe = firstframe & 0b00000111;
+    if ( !framecount ) { framecount = 1; }
+    if ( framecount > 8 - _firstframe ) { framecount = 8 - _firstframe; }
+    _framecount = framecount;
+
+    _hits = 0;
+    _misses = 0;
+
+    clear();
+
+}
+
+
+
+
+/// @brief Finds the frame holding an image.
+/// @param key The key of the image.
+/// @return The index in the pool, or 0xFF if it is not resident.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixFramePoolT< Transport >::_find( uint32_t key ) {
+
+    for ( uint8_t slot = 0 ; slot < _framecount ; slot++ ) {
+
+        if ( ( _valid & ( 0b00000001 << slot ) ) && ( _keys[ slot ] == key ) ) { return slot; }
+
+    }
+
+    return 0xFF;
+
+}
+
+
+/// @brief Picks the frame to put a new image in, an empty one if there is one, otherwise the least recently used.
+/// @return The index in the pool.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixFramePoolT< Transport >::_victim() {
+
+    uint8_t oldest = 0;
+
+    for ( uint8_t slot = 0 ; slot < _framecount ; slot++ ) {
+
+        if ( !( _valid & ( 0b00000001 << slot ) ) ) { return slot; }
+
+        if ( _age[ slot ] > _age[ oldest ] ) { oldest = slot; }
+
+    }
+
+    return oldest;
+
+}
+
+
+/// @brief Marks a frame as the most recently used.
+/// @param slot The index in the pool.
+template< class Transport >
+void Pimoroni_11x7matrixFramePoolT< Transport >::_touch( uint8_t slot ) {
+
+    // everything else gets a little older
+    for ( uint8_t i = 0 ; i < _framecount ; i++ ) {
+
+        if ( _age[ i ] < 255 ) { _age[ i ]++; }
+
+    }
+
+    _age[ slot ] = 0;
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+
+
+/// @brief Checks if an image is resident.  Does not count as using it.
+/// @param key The key of the image.
+/// @return 1 if it is in a frame, 0 if not.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixFramePoolT< Transport >::resident( uint32_t key ) {
+
+    return ( _find( key ) != 0xFF );
+
+}
+
+
+/// @brief Show an image.
+/// @param key The key of the image.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.  A failed upload leaves the image not resident.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixFramePoolT< Transport >::show( uint32_t key ) {
+
+    uint8_t slot = _find( key );
+
+    if ( slot == 0xFF ) {
+
+        slot = _victim();
+
+        // whatever was there is gone, whether the upload works or not
+        _valid &= ~( 0b00000001 << slot );
+
+        // the dirty flags know what this frame held, so only the difference goes out
+        uint8_t status = _matrix->pixelBufferWriteAllToFrame( _firstframe + slot );
+        if ( status ) { return status; }
+
+        _keys[ slot ] = key;
+        _valid |= ( 0b00000001 << slot );
+        _misses++;
+
+    }
+    else {
+
+        _hits++;
+
+    }
+
+    _touch( slot );
+
+    // already showing, nothing to send
+    if ( _matrix->frameDisplayPointerGet() == _firstframe + slot ) { return PIMORONI_11X7MATRIX_OK; }
+
+    return _matrix->frameDisplayPointerSet( _firstframe + slot );
+
+}
+
+
+/// @brief Show whatever is in the pixel buffers, keyed by pixelBufferHashGet().
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixFramePoolT< Transport >::showBuffer() {
+
+    return show( pixelBufferHashGet() );
+
+}
+
+
+/// @brief Gets a hash of the pixel buffers, state, blink and pwm.
+/// @return The hash.
+template< class Transport >
+uint32_t Pimoroni_11x7matrixFramePoolT< Transport >::pixelBufferHashGet() {
+
+    uint32_t hash = 2166136261UL;
+
+    // the frame image is exactly what would be sent, so hash that
+    for ( uint8_t address = 0 ; address <= PIMORONI_11X7MATRIX_FRAME_LAST_REG ; address++ ) {
+
+        hash ^= _matrix->_frameImageByte( address );
+        hash *= 16777619UL;
+
+    }
+
+    return hash;
+
+}
+
+
+
+
+/// @brief Forget one image, so the next show() of it uploads it again.
+/// @param key The key of the image.
+template< class Transport >
+void Pimoroni_11x7matrixFramePoolT< Transport >::invalidate( uint32_t key ) {
+
+    uint8_t slot = _find( key );
+
+    if ( slot != 0xFF ) { _valid &= ~( 0b00000001 << slot ); }
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+/// @brief Forget every image.
+template< class Transport >
+void Pimoroni_11x7matrixFramePoolT< Transport >::clear() {
+
+    _valid = 0x00;
+
+    for ( uint8_t slot = 0 ; slot < 8 ; slot++ ) {
+
+        _keys[ slot ] = 0;
+        _age[ slot ] = 0;
+
+    }
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+
+
+/// @brief Gets how many show() calls found their image resident.
+/// @return The count.
+template< class Transport >
+uint32_t Pimoroni_11x7matrixFramePoolT< Transport >::hitCountGet() {
+
+    return _hits;
+
+}
+
+
+/// @brief Gets how many show() calls had to upload their image.
+/// @return The count.
+template< class Transport >
+uint32_t Pimoroni_11x7matrixFramePoolT< Transport >::missCountGet() {
+
+    return _misses;
+
+}
+
+
+
+
+#endif
@@ -0,0 +1,2974 @@
+#ifndef PIMORONI_11X7MATRIX_IMPL_HEADER_GUARD
+#define PIMORONI_11X7MATRIX_IMPL_HEADER_GUARD
+
+
+// implementation of the 11x7 matrix driver template.
+// pimoroni_11x7matrix.cpp builds it for the default wire transport, include this yourself to build it for another transport.
+
+// include my header
+#include <pimoroni_11x7matrix.h>
+
+
+
+
+// the storage for the column and orientation tables, c++11 wants it out here as well.
+template< class Transport >
+constexpr uint8_t Pimoroni_11x7matrixT< Transport >::_columnToChipIndex[ 11 ];
+
+template< class Transport >
+constexpr uint8_t Pimoroni_11x7matrixT< Transport >::_orientColumn[ 2 ][ 11 ];
+
+template< class Transport >
+constexpr uint8_t Pimoroni_11x7matrixT< Transport >::_orientRow[ 2 ][ 7 ];
+
+
+
+
+/// @brief Constructor for Pimoroni 11x7 Matrix Driver
+/// @param transport The bus to talk to the chip over.
+template< class Transport >
+Pimoroni_11x7matrixT< Transport >::Pimoroni_11x7matrixT( const Transport &transport ) : _transport( transport ) {
+
+    // sensible defaults, so timeoutSet() can be called before begin()
+    _timeout = PIMORONI_11X7MATRIX_DEFAULT_TIMEOUT_US;
+    _laststatus = PIMORONI_11X7MATRIX_OK;
+    _busclock = 100000;
+    _currentframe = 0xFF;
+    _pushframe = 0xFF;
+    _doublebuffered = 0;
+    _brightnessonly = 0;
+    _gamma = 0;
+    _masterbrightness = 255;
+
+    // the right way up
+    _orientation = PIMORONI_11X7MATRIX_ROTATE_0;
+    _columnmap = _orientColumn[ 0 ];
+    _rowmap = _orientRow[ 0 ];
+
+    // the unconnected 8th pwm register of each column is sent as it is, so it has to start at zero
+    memset( _ledstate , 0 , sizeof( _ledstate ) );
+    memset( _ledblinkstate , 0 , sizeof( _ledblinkstate ) );
+    memset( _ledpwmstate , 0 , sizeof( _ledpwmstate ) );
+    _frontframe = 0;
+    _backframe = 1;
+
+    #if defined( PIMORONI_11X7MATRIX_INSTRUMENTATION )
+    _instrumentationapi = PIMORONI_11X7MATRIX_API_OTHER;
+    instrumentationReset();
+    #endif
+
+}
+
+
+
+
+
+
+/// @brief Set the i2c address and perform any setup required.
+/// @param new_i2c_address The i2c address of the chip.
+/// @param busclock The bus clock to try first, in hz.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::begin( uint8_t new_i2c_address , uint32_t busclock ) {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_BEGIN );
+
+    // start the bus, as fast as the chip will go
+    uint8_t status = _busStart( new_i2c_address , busclock );
+    if ( status ) { return status; }
+
+    // take a copy of the control registers, so setters and getters can use it.
+    status = _controlRegisterCacheLoad();
+    if ( status ) { return status; }
+
+    // turn off the chip
+    status = softwareShutdownSet( 0 );
+    if ( status ) { return status; }
+    
+    // set to picture display mode
+    status = displayModeSet( 0x00 );
+    if ( status ) { return status; }
+
+    // set the frame pointer to zero, which ends any double buffering
+    _doublebuffered = 0;
+    status = frameDisplayPointerSet( 0x00 );
+    if ( status ) { return status; }
+
+    // we have no idea what is in the frames, so everything needs sending
+    pixelBufferInvalidate();
+
+    // clear the buffers
+    pixelBufferClearAll();
+
+    // now write them out
+    status = pixelBufferWriteAllToFrame( 0x00 );
+    if ( status ) { return status; }
+
+    // now turn the chip back on, and tell the caller how it went.
+    return softwareShutdownSet( 1 );
+
+}
+
+
+
+
+/// @brief Take over a chip that is already running, without clearing the display.
+/// @param new_i2c_address The i2c address of the chip.
+/// @param busclock The bus clock to try first, in hz.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::resume( uint8_t new_i2c_address , uint32_t busclock ) {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_RESUME );
+
+    // start the bus, as fast as the chip will go
+    uint8_t status = _busStart( new_i2c_address , busclock );
+    if ( status ) { return status; }
+
+    // find out how the chip is set up
+    status = _controlRegisterCacheLoad();
+    if ( status ) { return status; }
+
+    // whatever we were double buffering before the reset is gone
+    _doublebuffered = 0;
+
+    // we have no idea what is in the other frames, so everything needs sending to them
+    pixelBufferInvalidate();
+
+    // and pick up whatever is on display now
+    return pixelBufferReadFromFrame( _controlregister[ IS31FL3731_ADDRESS_PICTURE_DISPLAY_REG ] & 0b00000111 );
+
+}
+
+
+
+
+/// @brief Start the wire library and find the fastest bus clock that works, up to the one asked for.
+/// @param new_i2c_address The i2c address of the chip.
+/// @param busclock The bus clock to try first, in hz.
+/// @return PIMORONI_11X7MATRIX_OK, or the error from the slowest clock tried.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::_busStart( uint8_t new_i2c_address , uint32_t busclock ) {
+
+    // make sure the bus is started.
+    _transport.begin();
+
+    // and that it can never hang on a wedged bus, where it supports it.
+    _transport.timeoutSet( _timeout );
+
+    // store my i2c address for later.
+    _i2c_address = new_i2c_address;
+
+    // we have no idea which page the chip has selected, so force a switch next time.
+    _currentframe = 0xFF;
+
+    // no batched control register changes yet.
+    _controlupdatedepth = 0;
+    _controlregisterdirty = 0x0000;
+
+    // try the clock we were asked for, then step down through fast mode and standard mode.
+    while ( 1 ) {
+
+        uint8_t status = _busClockTry( busclock );
+        if ( !status ) { return PIMORONI_11X7MATRIX_OK; }
+
+        if ( busclock > 400000 ) { busclock = 400000; }
+        else if ( busclock > 100000 ) { busclock = 100000; }
+        else { return status; }
+
+    }
+
+}
+
+
+/// @brief Set the bus clock, and check a write and read back work at that speed.
+/// @param busclock The bus clock in hz.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::_busClockTry( uint32_t busclock ) {
+
+    _transport.setClock( busclock );
+    _busclock = busclock;
+
+    // a failed try may have left the chip on any page
+    _currentframe = 0xFF;
+
+    // two patterns, so every bit has to go both ways
+    const uint8_t pattern[ 2 ] = { 0b01011010 , 0b10100101 };
+
+    for ( uint8_t i = 0 ; i < 2 ; i++ ) {
+
+        uint8_t readback = 0x00;
+
+        uint8_t status = _chipwritebyte( 0x00 , PIMORONI_11X7MATRIX_SCRATCH_REG , pattern[ i ] );
+        if ( status ) { return status; }
+
+        status = _chipreadbyte( 0x00 , PIMORONI_11X7MATRIX_SCRATCH_REG , &readback );
+        if ( status ) { return status; }
+
+        if ( readback != pattern[ i ] ) {
+
+            _laststatus = PIMORONI_11X7MATRIX_ERROR_VERIFY;
+            return _laststatus;
+
+        }
+
+    }
+
+    // put it back the way the frame image has it, and tell the caller how it went.
+    return _chipwritebyte( 0x00 , PIMORONI_11X7MATRIX_SCRATCH_REG , 0x00 );
+
+}
+
+
+
+
+/// @brief Finish a write transaction, remembering how it went.
+/// @return The result from the transport's endTransmission(). 0 is PIMORONI_11X7MATRIX_OK.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::_busEndTransmission() {
+
+    // say goodbye
+    _laststatus = _transport.endTransmission();
+
+    PIMORONI_11X7MATRIX_COUNT( transactions , 1 );
+    if ( ( _laststatus == PIMORONI_11X7MATRIX_ERROR_ADDRESS_NACK ) || ( _laststatus == PIMORONI_11X7MATRIX_ERROR_DATA_NACK ) ) { PIMORONI_11X7MATRIX_COUNT( nacks , 1 ); }
+
+    return _laststatus;
+
+}
+
+
+/// @brief Read bytes back from the chip, from wherever its address pointer is.  Never waits longer than the timeout.
+/// @param data Where to put the bytes.
+/// @param count How many bytes to read.  No more than the wire buffer size.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::_busRead( uint8_t *data , uint8_t count ) {
+
+    PIMORONI_11X7MATRIX_COUNT( transactions , 1 );
+
+    // ask the chip for them, nothing back means nobody answered.
+    if ( !_transport.requestFrom( _i2c_address , count ) ) {
+
+        PIMORONI_11X7MATRIX_COUNT( nacks , 1 );
+        _laststatus = PIMORONI_11X7MATRIX_ERROR_ADDRESS_NACK;
+        return _laststatus;
+
+    }
+
+    // some cores fill the buffer in the background, so wait for it, but not forever.
+    uint32_t starttime = micros();
+
+    while ( _transport.available() < count ) {
+
+        if ( ( micros() - starttime ) > _timeout ) {
+
+            _laststatus = PIMORONI_11X7MATRIX_ERROR_TIMEOUT;
+            return _laststatus;
+
+        }
+
+    }
+
+    // copy them out
+    for ( uint8_t i = 0 ; i < count ; i++ ) {
+
+        data[ i ] = (uint8_t)( _transport.read() );
+
+    }
+
+    PIMORONI_11X7MATRIX_COUNT( bytesread , count );
+
+    // all done, return to caller
+    _laststatus = PIMORONI_11X7MATRIX_OK;
+    return _laststatus;
+
+}
+
+
+/// @brief Queue a byte to write, counting it.
+/// @param data The byte.
+template< class Transport >
+void Pimoroni_11x7matrixT< Transport >::_busWrite( uint8_t data ) {
+
+    _transport.write( data );
+
+    PIMORONI_11X7MATRIX_COUNT( byteswritten , 1 );
+
+}
+
+
+/// @brief Queue several bytes to write, counting them.
+/// @param data The bytes.
+/// @param count How many bytes.
+template< class Transport >
+void Pimoroni_11x7matrixT< Transport >::_busWrite( const uint8_t *data , uint8_t count ) {
+
+    _transport.write( data , count );
+
+    PIMORONI_11X7MATRIX_COUNT( byteswritten , count );
+
+}
+
+
+/// @brief Write a single byte of data to the chip.
+/// @param framenumber The number of the frame to write to. 0x00-0x07 Animation. 0x0B Control.
+/// @param address The address within the frame to write to.
+/// @param data The data byte to write to the chip.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::_chipwritebyte( uint8_t framenumber , uint8_t address , uint8_t data ) {
+
+
+    uint8_t status = _switchFrame( framenumber );
+    if ( status ) { return status; }
+
+    // say hello to the chip again...
+    _transport.beginTransmission( _i2c_address );
+
+    // send the address
+    _busWrite( address );
+
+    // send the data
+    _busWrite( data );
+
+    // say goodbye, and tell the caller how it went.
+    return _busEndTransmission();
+    
+}
+
+
+/// @brief Read a single byte of data from the chip.
+/// @param framenumber The number of the frame to read from. 0x00-0x07 Animation. 0x0B Control.
+/// @param address The address within the frame to read from.
+/// @param data Where to put the byte returned from the chip.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::_chipreadbyte( uint8_t framenumber , uint8_t address , uint8_t *data ) {
+
+    uint8_t status = _switchFrame( framenumber );
+    if ( status ) { return status; }
+
+    // say hello to the chip again...
+    _transport.beginTransmission( _i2c_address );
+    
+    // send the address
+    _busWrite( address );
+
+    // say goodye to the chip
+    status = _busEndTransmission();
+    if ( status ) { return status; }
+
+    // receive one byte back from the chip
+    return _busRead( data , 1 );
+
+}
+
+
+
+
+/// @brief Write a control register, keeping the shadow copy up to date.
+/// If the write fails the register is marked changed, so the next commit() sends it again.
+/// @param address The address within the control page to write to. 0x00-0x0C.
+/// @param data The data byte to write to the chip.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::_controlRegisterWrite( uint8_t address , uint8_t data ) {
+
+    // update the shadow copy first
+    _controlregister[ address ] = data;
+
+    // if we are inside an update, just remember it for commit()
+    if ( _controlupdatedepth ) {
+
+        _controlregisterdirty |= ( (uint16_t)( 0x0001 ) << address );
+
+        return PIMORONI_11X7MATRIX_OK;
+
+    }
+
+    // otherwise write it through to the chip
+    uint8_t status = _chipwritebyte( IS31FL3731_PAGE_CONTROL , address , data );
+
+    // the getters read the shadow copy, so if the chip never got it, remember to send it with the next commit()
+    if ( status ) {
+
+        _controlregisterdirty |= ( (uint16_t)( 0x0001 ) << address );
+
+        return status;
+
+    }
+
+    // the chip has it now, whatever an earlier failure left behind
+    _controlregisterdirty &= ~( (uint16_t)( 0x0001 ) << address );
+
+    return PIMORONI_11X7MATRIX_OK;
+
+}
+
+
+/// @brief Point the display at a frame straight away, even inside beginUpdate().
+/// Double buffering relies on the chip showing the front frame, so this never waits for commit().
+/// If the write fails the shadow copy is left as it was, and nothing is resent later.
+/// @param framenumber The frame to show. 0-7.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::_displayFrameWrite( uint8_t framenumber ) {
+
+    uint8_t status = _chipwritebyte( IS31FL3731_PAGE_CONTROL , IS31FL3731_ADDRESS_PICTURE_DISPLAY_REG , framenumber );
+    if ( status ) { return status; }
+
+    // the chip has it, so there is nothing left for commit() to send
+    _controlregister[ IS31FL3731_ADDRESS_PICTURE_DISPLAY_REG ] = framenumber;
+    _controlregisterdirty &= ~( (uint16_t)( 0x0001 ) << IS31FL3731_ADDRESS_PICTURE_DISPLAY_REG );
+
+    return PIMORONI_11X7MATRIX_OK;
+
+}
+
+
+/// @brief Fill the control register shadow copy from the chip.
+/// The frame state register 0x07 is skipped, reading it would clear the frame interrupt.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::_controlRegisterCacheLoad() {
+
+    uint8_t status = _switchFrame( IS31FL3731_PAGE_CONTROL );
+    if ( status ) { return status; }
+
+    // two bursts, either side of the frame state register, 0x00-0x06 then 0x08-0x0C
+    uint8_t first = IS31FL3731_ADDRESS_CONFIG_REG;
+    uint8_t count = IS31FL3731_ADDRESS_FRAME_STATE_REG - first;
+
+    for ( uint8_t burst = 0 ; burst < 2 ; burst++ ) {
+
+        // say hello to the chip again...
+        _transport.beginTransmission( _i2c_address );
+
+        // send the base address, the chip auto increments from here
+        _busWrite( first );
+
+        // say goodbye to the chip
+        status = _busEndTransmission();
+        if ( status ) { return status; }
+
+        // read this side back into the shadow in one go
+        status = _busRead( &_controlregister[ first ] , count );
+        if ( status ) { return status; }
+
+        // and on to the other side
+        first = IS31FL3731_ADDRESS_FRAME_STATE_REG + 1;
+        count = IS31FL3731_CONTROL_REGISTER_COUNT - first;
+
+    }
+
+    // all done, return to caller.
+    return PIMORONI_11X7MATRIX_OK;
+
+}
+
+
+
+
+
+
+
+
+
+
+
+/// @brief Optimised write to chip.
+/// @param framenumber The frame number to write to.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::_pixelBufferStateFastWrite( uint8_t framenumber ) {
+
+    return _frameImageWrite( framenumber , PIMORONI_11X7MATRIX_BUFFER_STATE );
+
+}
+
+
+/// @brief Optimised write to chip.
+/// @param framenumber The frame number to write to.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::_pixelBufferBlinkStateFastWrite( uint8_t framenumber ) {
+    
+    return _frameImageWrite( framenumber , PIMORONI_11X7MATRIX_BUFFER_BLINK );
+
+}
+
+
+/// @brief Optimised write to chip.
+/// @param  framenumber The frame number to write to.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::_pixelBufferpwmStateFastWrite( uint8_t framenumber ) {
+
+    return _frameImageWrite( framenumber , PIMORONI_11X7MATRIX_BUFFER_PWM );
+
+}
+
+
+/// @brief Store a new column byte in a bit buffer, marking it dirty if it changed.
+/// @param buffer The bit buffer to store into, _ledstate or _ledblinkstate.
+/// @param dirty The dirty flags belonging to the buffer.
+/// @param chipindex The chip index of the column. 0-10.
+/// @param data The new column byte.
+template< class Transport >
+void Pimoroni_11x7matrixT< Transport >::_bitBufferColumnSet( uint8_t *buffer , uint8_t *dirty , uint8_t chipindex , uint8_t data ) {
+
+    // nothing to do if it has not changed
+    if ( buffer[ chipindex ] == data ) { return; }
+
+    // store the new byte
+    buffer[ chipindex ] = data;
+
+    // and every frame now needs this column again
+    dirty[ chipindex ] = 0xFF;
+
+    // all done, return to caller
+    return;
+
+}
+
+
+/// @brief Store a new pwm value, marking its column dirty if it changed.
+/// @param chipindex The chip index of the pixel's column. 0-10.
+/// @param ypos The y position of the pixel.
+/// @param data The new pwm value.
+template< class Transport >
+void Pimoroni_11x7matrixT< Transport >::_pwmBufferSet( uint8_t chipindex , uint8_t ypos , uint8_t data ) {
+
+    #if defined( PIMORONI_11X7MATRIX_PACKED_PWM )
+
+    // which nibble of which byte
+    uint8_t pixel = chipindex * 7 + ypos;
+    uint8_t shift = ( pixel & 0b00000001 ) ? 4 : 0;
+    uint8_t tempbyte = _ledpwmstate[ pixel >> 1 ];
+
+    // swap in the new level
+    tempbyte = ( tempbyte & ~( 0b00001111 << shift ) ) | ( _pwmLevelFind( data ) << shift );
+
+    // nothing to do if it has not changed
+    if ( _ledpwmstate[ pixel >> 1 ] == tempbyte ) { return; }
+
+    // store the new level
+    _ledpwmstate[ pixel >> 1 ] = tempbyte;
+
+    #else
+
+    // nothing to do if it has not changed
+    if ( _ledpwmstate[ chipindex ][ ypos ] == data ) { return; }
+
+    // store the new value
+    _ledpwmstate[ chipindex ][ ypos ] = data;
+
+    #endif
+
+    // and every frame now needs this column again
+    _ledpwmstatedirty[ chipindex ] = 0xFF;
+
+    // all done, return to caller
+    return;
+
+}
+
+
+/// @brief Gets a pwm value from the pixel buffer.
+/// @param chipindex The chip index of the pixel's column. 0-10.
+/// @param ypos The y position of the pixel.
+/// @return The pwm value.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::_pwmBufferGet( uint8_t chipindex , uint8_t ypos ) {
+
+    #if defined( PIMORONI_11X7MATRIX_PACKED_PWM )
+
+    // which nibble of which byte
+    uint8_t pixel = chipindex * 7 + ypos;
+    uint8_t level = ( _ledpwmstate[ pixel >> 1 ] >> ( ( pixel & 0b00000001 ) ? 4 : 0 ) ) & 0b00001111;
+
+    // and what that level means
+    return pgm_read_byte( &pimoroni_11x7matrixPwmLevels[ level ] );
+
+    #else
+
+    return _ledpwmstate[ chipindex ][ ypos ];
+
+    #endif
+
+}
+
+
+#if defined( PIMORONI_11X7MATRIX_PACKED_PWM )
+
+/// @brief Finds the nearest packed mode level to a pwm value.
+/// @param data The pwm value.
+/// @return The level. 0-15.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::_pwmLevelFind( uint8_t data ) {
+
+    // the highest level not above it
+    uint8_t level = 0;
+    while ( ( level < 15 ) && ( pgm_read_byte( &pimoroni_11x7matrixPwmLevels[ level + 1 ] ) <= data ) ) { level++; }
+
+    if ( level == 15 ) { return level; }
+
+    // then whichever of it and the next one up is closer
+    uint8_t below = data - pgm_read_byte( &pimoroni_11x7matrixPwmLevels[ level ] );
+    uint8_t above = pgm_read_byte( &pimoroni_11x7matrixPwmLevels[ level + 1 ] ) - data;
+
+    return ( above < below ) ? level + 1 : level;
+
+}
+
+#endif
+
+
+/// @brief Finds where a register of the frame image is kept in the pixel buffers.
+/// @param address The register address within the frame. 0x00-0x7A.
+/// @param count Set to how many registers from there on are kept straight after it, or are unused along with it.  Never past 0x7A.
+/// @return The buffer byte holding the register, or NULL if this board does not use it and it is always zero.
+template< class Transport >
+const uint8_t *Pimoroni_11x7matrixT< Transport >::_frameImageSpan( uint8_t address , uint8_t *count ) {
+
+    // led on/off state, 0x00-0x0A
+    if ( address < IS31FL3731_ADDRESS_LED_CONTROL_REG + 11 ) {
+
+        *count = IS31FL3731_ADDRESS_LED_CONTROL_REG + 11 - address;
+        return &_ledstate[ address - IS31FL3731_ADDRESS_LED_CONTROL_REG ];
+
+    }
+
+    // the rest of the led control registers are not used
+    if ( address < IS31FL3731_ADDRESS_BLINK_CONTROL_REG ) {
+
+        *count = IS31FL3731_ADDRESS_BLINK_CONTROL_REG - address;
+        return NULL;
+
+    }
+
+    // led blink state, 0x12-0x1C
+    if ( address < IS31FL3731_ADDRESS_BLINK_CONTROL_REG + 11 ) {
+
+        *count = IS31FL3731_ADDRESS_BLINK_CONTROL_REG + 11 - address;
+        return &_ledblinkstate[ address - IS31FL3731_ADDRESS_BLINK_CONTROL_REG ];
+
+    }
+
+    // nor are the rest of the blink registers
+    if ( address < IS31FL3731_ADDRESS_PWM_REG ) {
+
+        *count = IS31FL3731_ADDRESS_PWM_REG - address;
+        return NULL;
+
+    }
+
+    // pwm, 8 registers per column from 0x24, all the way to the end.
+    *count = PIMORONI_11X7MATRIX_FRAME_LAST_REG + 1 - address;
+
+    #if defined( PIMORONI_11X7MATRIX_PACKED_PWM )
+
+    // the levels get looked up on the way out
+    return NULL;
+
+    #else
+
+    // so do the gamma curve and master brightness
+    if ( _gamma || ( _masterbrightness != 255 ) ) { return NULL; }
+
+    // the 8th of each is the zero we keep for it
+    return &_ledpwmstate[ 0 ][ 0 ] + ( address - IS31FL3731_ADDRESS_PWM_REG );
+
+    #endif
+
+}
+
+
+/// @brief Gets the byte the chip should hold at a register in a frame, built from the pixel buffers.
+/// @param address The register address within the frame. 0x00-0x7A.
+/// @return The register byte.  Registers this board does not use are zero.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::_frameImageByte( uint8_t address ) {
+
+    // pwm, 8 registers per column from 0x24, the 8th is not connected on this board.
+    if ( address >= IS31FL3731_ADDRESS_PWM_REG ) {
+
+        uint8_t offset = address - IS31FL3731_ADDRESS_PWM_REG;
+        if ( ( offset & 0b00000111 ) == 0b00000111 ) { return 0x00; }
+
+        return _pwmOutput( _pwmBufferGet( offset >> 3 , offset & 0b00000111 ) );
+
+    }
+
+    uint8_t count;
+    const uint8_t *span = _frameImageSpan( address , &count );
+
+    return span ? *span : 0x00;
+
+}
+
+
+/// @brief Checks if a register belongs to a column that needs sending.
+/// @param address The register address within the frame. 0x00-0x7A.
+/// @param mask The columns that need sending.
+/// @return 1 if the register needs sending, 0 if not.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::_frameImageWanted( uint8_t address , const Pimoroni_11x7matrixFrameMask *mask ) {
+
+    // led on/off state, 0x00-0x0A
+    if ( address < IS31FL3731_ADDRESS_LED_CONTROL_REG + 11 ) { return ( mask->state >> address ) & 0b00000001; }
+
+    // led blink state, 0x12-0x1C
+    if ( address < IS31FL3731_ADDRESS_BLINK_CONTROL_REG ) { return 0; }
+    if ( address < IS31FL3731_ADDRESS_BLINK_CONTROL_REG + 11 ) { return ( mask->blink >> ( address - IS31FL3731_ADDRESS_BLINK_CONTROL_REG ) ) & 0b00000001; }
+
+    // pwm, 8 registers per column from 0x24, the 8th is never wanted.
+    if ( address < IS31FL3731_ADDRESS_PWM_REG ) { return 0; }
+
+    uint8_t offset = address - IS31FL3731_ADDRESS_PWM_REG;
+    if ( ( offset & 0b00000111 ) == 0b00000111 ) { return 0; }
+
+    return ( mask->pwm >> ( offset >> 3 ) ) & 0b00000001;
+
+}
+
+
+/// @brief Collects the dirty columns of a frame into a mask, and marks them as sent.
+/// @param framenumber The frame number that is about to be written. 0-7.
+/// @param buffers Which buffers to collect, PIMORONI_11X7MATRIX_BUFFER_STATE, _BLINK and _PWM or'd together.
+/// @param mask Where to put the columns that need sending.
+template< class Transport >
+void Pimoroni_11x7matrixT< Transport >::_frameImageDirtyTake( uint8_t framenumber , uint8_t buffers , Pimoroni_11x7matrixFrameMask *mask ) {
+
+    // the bit for this frame in the dirty flags
+    uint8_t framebit = ( 0b00000001 << framenumber );
+
+    // start with nothing to send
+    mask->state = 0x0000;
+    mask->blink = 0x0000;
+    mask->pwm = 0x0000;
+
+    // one bit per chip index, the dirty flags are in chip order already
+    for ( uint8_t chipindex = 0 ; chipindex < 11 ; chipindex++ ) {
+
+        if ( ( buffers & PIMORONI_11X7MATRIX_BUFFER_STATE ) && ( _ledstatedirty[ chipindex ] & framebit ) ) { mask->state |= ( (uint16_t)( 0x0001 ) << chipindex ); }
+        if ( ( buffers & PIMORONI_11X7MATRIX_BUFFER_BLINK ) && ( _ledblinkstatedirty[ chipindex ] & framebit ) ) { mask->blink |= ( (uint16_t)( 0x0001 ) << chipindex ); }
+        if ( ( buffers & PIMORONI_11X7MATRIX_BUFFER_PWM ) && ( _ledpwmstatedirty[ chipindex ] & framebit ) ) { mask->pwm |= ( (uint16_t)( 0x0001 ) << chipindex ); }
+
+        if ( buffers & PIMORONI_11X7MATRIX_BUFFER_STATE ) { _ledstatedirty[ chipindex ] &= ~framebit; }
+        if ( buffers & PIMORONI_11X7MATRIX_BUFFER_BLINK ) { _ledblinkstatedirty[ chipindex ] &= ~framebit; }
+        if ( buffers & PIMORONI_11X7MATRIX_BUFFER_PWM ) { _ledpwmstatedirty[ chipindex ] &= ~framebit; }
+
+    }
+
+    // all done, return to caller
+    return;
+
+}
+
+
+/// @brief Sends the next run of wanted registers as one transaction, filled up to the wire buffer size.
+/// @param framenumber The frame number to write to. 0-7.
+/// @param address The register to start looking from.  Moved on past whatever was sent, past 0x7A when there is nothing left.
+/// @param mask The columns that need sending.
+/// @param image A copy of the frame image to send from, or NULL to send from the pixel buffers.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::_frameImageRunWrite( uint8_t framenumber , uint8_t *address , const Pimoroni_11x7matrixFrameMask *mask , const uint8_t *image ) {
+
+    // skip over anything that does not need sending
+    while ( ( *address <= PIMORONI_11X7MATRIX_FRAME_LAST_REG ) && !_frameImageWanted( *address , mask ) ) { (*address)++; }
+
+    // nothing left?
+    if ( *address > PIMORONI_11X7MATRIX_FRAME_LAST_REG ) { return PIMORONI_11X7MATRIX_OK; }
+
+    uint8_t status = _switchFrame( framenumber );
+    if ( status ) { return status; }
+
+    // first work out where the run ends, one past the last register in it.
+    uint8_t start = *address;
+    uint8_t end = start + 1;
+
+    while ( 1 ) {
+
+        // stop at the end of the frame, or when the wire buffer is full
+        if ( end > PIMORONI_11X7MATRIX_FRAME_LAST_REG ) { break; }
+        if ( end - start >= ( PIMORONI_11X7MATRIX_WIRE_BUFFER_SIZE - 1 ) ) { break; }
+
+        // carry straight on if the next register is wanted
+        if ( _frameImageWanted( end , mask ) ) { end++; continue; }
+
+        // otherwise measure the gap to the next wanted register
+        uint8_t gap = 1;
+        while ( ( end + gap <= PIMORONI_11X7MATRIX_FRAME_LAST_REG ) && !_frameImageWanted( end + gap , mask ) ) { gap++; }
+
+        // nothing more to send after the gap
+        if ( end + gap > PIMORONI_11X7MATRIX_FRAME_LAST_REG ) { break; }
+
+        // only pad over the gap if that is cheaper than a new transaction, and the register after it still fits.
+        // the padding rewrites clean registers with what the chip already holds.
+        if ( gap >= PIMORONI_11X7MATRIX_TRANSACTION_OVERHEAD_BYTES ) { break; }
+        if ( end - start + gap >= ( PIMORONI_11X7MATRIX_WIRE_BUFFER_SIZE - 1 ) ) { break; }
+
+        // take in the gap and the register after it
+        end += gap + 1;
+
+    }
+
+    *address = end;
+
+    // say hello to the chip again...
+    _transport.beginTransmission( _i2c_address );
+
+    // send the address of the first register in this run, the chip auto increments from here
+    _busWrite( start );
+
+    // a snapshot is one straight copy
+    if ( image ) { _busWrite( &image[ start ] , end - start ); }
+
+    // the pixel buffers are in register order, so each one is a straight copy too
+    while ( !image && ( start < end ) ) {
+
+        uint8_t count;
+        const uint8_t *span = _frameImageSpan( start , &count );
+        if ( count > end - start ) { count = end - start; }
+
+        if ( span ) { _busWrite( span , count ); }
+        else { for ( uint8_t i = 0 ; i < count ; i++ ) { _busWrite( _frameImageByte( start + i ) ); } }
+
+        start += count;
+
+    }
+
+    // say goodbye, and tell the caller how it went.
+    return _busEndTransmission();
+
+}
+
+
+/// @brief Store a register byte read back from the chip into a frame buffer, undoing the column interleave.
+/// @param address The register address within the frame. 0x00-0x7A.
+/// @param data The register byte.
+/// @param buffer The frame buffer to store into.  Registers this board does not use are ignored.
+template< class Transport >
+void Pimoroni_11x7matrixT< Transport >::_frameImageDecode( uint8_t address , uint8_t data , Pimoroni_11x7matrixFrameBuffer *buffer ) {
+
+    // led on/off state, 0x00-0x0A
+    if ( address < IS31FL3731_ADDRESS_LED_CONTROL_REG + 11 ) { buffer->state[ _chipIndexToColumn( address ) ] = data; return; }
+
+    // led blink state, 0x12-0x1C
+    if ( address < IS31FL3731_ADDRESS_BLINK_CONTROL_REG ) { return; }
+    if ( address < IS31FL3731_ADDRESS_BLINK_CONTROL_REG + 11 ) { buffer->blink[ _chipIndexToColumn( address - IS31FL3731_ADDRESS_BLINK_CONTROL_REG ) ] = data; return; }
+
+    // pwm, 8 registers per column from 0x24, the 8th is not connected on this board.
+    if ( address < IS31FL3731_ADDRESS_PWM_REG ) { return; }
+
+    uint8_t offset = address - IS31FL3731_ADDRESS_PWM_REG;
+    if ( ( offset & 0b00000111 ) == 0b00000111 ) { return; }
+
+    buffer->pwm[ _chipIndexToColumn( offset >> 3 ) ][ offset & 0b00000111 ] = data;
+
+    // all done, return to caller
+    return;
+
+}
+
+
+/// @brief Read registers 0x00-0x7A of a frame back from the chip.
+/// @param framenumber The frame number to read. 0-7.
+/// @param buffer Where to put the frame.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::_frameImageRead( uint8_t framenumber , Pimoroni_11x7matrixFrameBuffer *buffer ) {
+
+    uint8_t status = _switchFrame( framenumber );
+    if ( status ) { return status; }
+
+    // say hello to the chip again...
+    _transport.beginTransmission( _i2c_address );
+
+    // send the address of the first register, the chip auto increments from here, across reads too.
+    _busWrite( IS31FL3731_ADDRESS_LED_CONTROL_REG );
+
+    // say goodbye to the chip
+    status = _busEndTransmission();
+    if ( status ) { return status; }
+
+    // now read it back a wire buffer at a time
+    uint8_t chunk[ PIMORONI_11X7MATRIX_WIRE_BUFFER_SIZE ];
+    uint8_t address = IS31FL3731_ADDRESS_LED_CONTROL_REG;
+
+    while ( address <= PIMORONI_11X7MATRIX_FRAME_LAST_REG ) {
+
+        // no more than is left
+        uint8_t count = PIMORONI_11X7MATRIX_FRAME_LAST_REG + 1 - address;
+        if ( count > PIMORONI_11X7MATRIX_WIRE_BUFFER_SIZE ) { count = PIMORONI_11X7MATRIX_WIRE_BUFFER_SIZE; }
+
+        status = _busRead( chunk , count );
+        if ( status ) { return status; }
+
+        // sort it out into the frame buffer
+        for ( uint8_t i = 0 ; i < count ; i++ ) {
+
+            _frameImageDecode( address , chunk[ i ] , buffer );
+            address++;
+
+        }
+
+    }
+
+    // all done, return to caller
+    return PIMORONI_11X7MATRIX_OK;
+
+}
+
+
+/// @brief Hands columns that could not be sent back to the dirty flags, so the next write tries again.
+/// @param framenumber The frame number the columns were meant for. 0-7.
+/// @param mask The columns that did not make it.
+template< class Transport >
+void Pimoroni_11x7matrixT< Transport >::_frameImageDirtyReturn( uint8_t framenumber , const Pimoroni_11x7matrixFrameMask *mask ) {
+
+    // the bit for this frame in the dirty flags
+    uint8_t framebit = ( 0b00000001 << framenumber );
+
+    // one bit per chip index
+    for ( uint8_t chipindex = 0 ; chipindex < 11 ; chipindex++ ) {
+
+        if ( ( mask->state >> chipindex ) & 0b00000001 ) { _ledstatedirty[ chipindex ] |= framebit; }
+        if ( ( mask->blink >> chipindex ) & 0b00000001 ) { _ledblinkstatedirty[ chipindex ] |= framebit; }
+        if ( ( mask->pwm >> chipindex ) & 0b00000001 ) { _ledpwmstatedirty[ chipindex ] |= framebit; }
+
+    }
+
+    // all done, return to caller
+    return;
+
+}
+
+
+/// @brief Send the dirty parts of the pixel buffers to a frame, in as few transactions as possible.
+/// @param framenumber The frame number to write to. 0-7.
+/// @param buffers Which buffers to send, PIMORONI_11X7MATRIX_BUFFER_STATE, _BLINK and _PWM or'd together.
+/// @return PIMORONI_11X7MATRIX_OK, PIMORONI_11X7MATRIX_ERROR_BUSY if a pusher is still streaming to the frame, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::_frameImageWrite( uint8_t framenumber , uint8_t buffers ) {
+
+    // the pusher's older snapshot would land on top of whatever we sent
+    if ( framenumber == _pushframe ) {
+
+        _laststatus = PIMORONI_11X7MATRIX_ERROR_BUSY;
+        return _laststatus;
+
+    }
+
+    // find out what needs sending
+    Pimoroni_11x7matrixFrameMask mask;
+    _frameImageDirtyTake( framenumber , buffers , &mask );
+
+    // then send it, one run at a time
+    uint8_t address = 0x00;
+
+    while ( address <= PIMORONI_11X7MATRIX_FRAME_LAST_REG ) {
+
+        uint8_t status = _frameImageRunWrite( framenumber , &address , &mask , NULL );
+
+        // if anything went wrong we can't tell what made it, so it all needs sending again.
+        if ( status ) {
+
+            _frameImageDirtyReturn( framenumber , &mask );
+            return status;
+
+        }
+
+    }
+
+    // all done, return to caller
+    return PIMORONI_11X7MATRIX_OK;
+
+}
+
+
+
+
+
+
+/// @brief Switch to a different frame, if necessary.
+/// @param framenumber The frame number to switch to.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::_switchFrame( uint8_t framenumber ) {
+
+    // check if we need to switch at all?
+    if ( framenumber == _currentframe ) {
+
+        PIMORONI_11X7MATRIX_COUNT( pageswitchesavoided , 1 );
+        return PIMORONI_11X7MATRIX_OK;
+
+    }
+
+    PIMORONI_11X7MATRIX_COUNT( pageswitches , 1 );
+
+    // ok, we need to switch now, perform an i2c transaction.
+    _transport.beginTransmission( _i2c_address );
+    _busWrite( 0xFD );
+    _busWrite( framenumber );
+
+    // if that failed we no longer know which page is selected.
+    if ( _busEndTransmission() ) {
+
+        _currentframe = 0xFF;
+        return _laststatus;
+
+    }
+
+    // now update our current frame number
+    _currentframe = framenumber;
+
+    // all done, return to caller.
+    return PIMORONI_11X7MATRIX_OK;
+    
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+/*
+
+********************* public methods below.
+
+*/
+
+
+
+
+
+
+
+
+
+/// @brief Sets how long a read may wait for the chip before giving up.
+/// @param microseconds The timeout in microseconds.
+template< class Transport >
+void Pimoroni_11x7matrixT< Transport >::timeoutSet( uint32_t microseconds ) {
+
+    _timeout = microseconds;
+
+    // the bus can time out writes too, where it supports it.
+    _transport.timeoutSet( _timeout );
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+/// @brief Gets how long a read may wait for the chip before giving up.
+/// @return The timeout in microseconds.
+template< class Transport >
+uint32_t Pimoroni_11x7matrixT< Transport >::timeoutGet() {
+
+    return _timeout;
+
+}
+
+
+/// @brief Gets the bus clock begin() settled on.
+/// @return The bus clock in hz.
+template< class Transport >
+uint32_t Pimoroni_11x7matrixT< Transport >::busClockGet() {
+
+    return _busclock;
+
+}
+
+
+/// @brief Gets the result of the last bus transaction.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::lastStatusGet() {
+
+    return _laststatus;
+
+}
+
+
+/// @brief Try to free a stuck bus, then restart the bus.
+/// @return PIMORONI_11X7MATRIX_OK, or PIMORONI_11X7MATRIX_ERROR_BUS_STUCK if the bus is still held low.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::busRecover() {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_BUS_RECOVER );
+
+    uint8_t status = PIMORONI_11X7MATRIX_OK;
+
+    // the transport knows which pins to wiggle
+    if ( _transport.recover() ) { status = PIMORONI_11X7MATRIX_ERROR_BUS_STUCK; }
+
+    // put the clock and timeout back the way we had them
+    _transport.setClock( _busclock );
+    _transport.timeoutSet( _timeout );
+
+    // the chip may have missed a page select
+    _currentframe = 0xFF;
+
+    _laststatus = status;
+    return status;
+
+}
+
+
+
+
+
+/// @brief Gets the bus traffic and time counted for one call since the last instrumentationReset().
+/// @param api The call, PIMORONI_11X7MATRIX_API_BEGIN and so on.
+/// @param counters Where to put the counts.
+template< class Transport >
+void Pimoroni_11x7matrixT< Transport >::instrumentationGet( uint8_t api , Pimoroni_11x7matrixInstrumentation *counters ) {
+
+    memset( counters , 0 , sizeof( Pimoroni_11x7matrixInstrumentation ) );
+
+    #if defined( PIMORONI_11X7MATRIX_INSTRUMENTATION )
+    if ( api < PIMORONI_11X7MATRIX_API_COUNT ) { *counters = _instrumentation[ api ]; }
+    #else
+    (void)( api );
+    #endif
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+/// @brief Puts all the instrumentation counts back to zero.
+template< class Transport >
+void Pimoroni_11x7matrixT< Transport >::instrumentationReset() {
+
+    #if defined( PIMORONI_11X7MATRIX_INSTRUMENTATION )
+    memset( _instrumentation , 0 , sizeof( _instrumentation ) );
+    #endif
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+/// @brief Prints the instrumentation counts over Serial, one line per call that did anything.
+template< class Transport >
+void Pimoroni_11x7matrixT< Transport >::instrumentationDump() {
+
+    #if defined( PIMORONI_11X7MATRIX_INSTRUMENTATION )
+
+    for ( uint8_t api = 0 ; api < PIMORONI_11X7MATRIX_API_COUNT ; api++ ) {
+
+        const Pimoroni_11x7matrixInstrumentation *counters = &_instrumentation[ api ];
+
+        // skip anything that never happened
+        if ( !counters->calls && !counters->transactions ) { continue; }
+
+        switch ( api ) {
+
+            case PIMORONI_11X7MATRIX_API_BEGIN: Serial.print( F( "begin" ) ); break;
+            case PIMORONI_11X7MATRIX_API_RESUME: Serial.print( F( "resume" ) ); break;
+            case PIMORONI_11X7MATRIX_API_BUS_RECOVER: Serial.print( F( "busRecover" ) ); break;
+            case PIMORONI_11X7MATRIX_API_WRITE_ALL: Serial.print( F( "pixelBufferWriteAllToFrame" ) ); break;
+            case PIMORONI_11X7MATRIX_API_WRITE_STATE: Serial.print( F( "pixelBufferStateWriteToFrame" ) ); break;
+            case PIMORONI_11X7MATRIX_API_WRITE_BLINK: Serial.print( F( "pixelBufferBlinkStateWriteToFrame" ) ); break;
+            case PIMORONI_11X7MATRIX_API_WRITE_PWM: Serial.print( F( "pixelBufferpwmStateWriteToFrame" ) ); break;
+            case PIMORONI_11X7MATRIX_API_FRAME_READ: Serial.print( F( "frameRead" ) ); break;
+            case PIMORONI_11X7MATRIX_API_FRAME_VERIFY: Serial.print( F( "pixelBufferVerifyFrame" ) ); break;
+            case PIMORONI_11X7MATRIX_API_CONTROL_READ: Serial.print( F( "controlRegisterReadback" ) ); break;
+            case PIMORONI_11X7MATRIX_API_COMMIT: Serial.print( F( "commit" ) ); break;
+            case PIMORONI_11X7MATRIX_API_CONTROL_SET: Serial.print( F( "controlSet" ) ); break;
+            case PIMORONI_11X7MATRIX_API_FRAME_STATE_GET: Serial.print( F( "frameStateGet" ) ); break;
+            case PIMORONI_11X7MATRIX_API_PUSHER: Serial.print( F( "pusher" ) ); break;
+            case PIMORONI_11X7MATRIX_API_PRESENT: Serial.print( F( "present" ) ); break;
+            case PIMORONI_11X7MATRIX_API_DOUBLE_BUFFER: Serial.print( F( "doubleBufferBegin" ) ); break;
+            default: Serial.print( F( "other" ) ); break;
+
+        }
+
+        // key=value pairs, easy to pick apart on the other end
+        Serial.print( F( " calls=" ) ); Serial.print( counters->calls );
+        Serial.print( F( " us=" ) ); Serial.print( counters->micros );
+        Serial.print( F( " tx=" ) ); Serial.print( counters->transactions );
+        Serial.print( F( " wr=" ) ); Serial.print( counters->byteswritten );
+        Serial.print( F( " rd=" ) ); Serial.print( counters->bytesread );
+        Serial.print( F( " page=" ) ); Serial.print( counters->pageswitches );
+        Serial.print( F( " pagesaved=" ) ); Serial.print( counters->pageswitchesavoided );
+        Serial.print( F( " nack=" ) ); Serial.println( counters->nacks );
+
+    }
+
+    #else
+
+    Serial.println( F( "instrumentation not compiled in, define PIMORONI_11X7MATRIX_INSTRUMENTATION" ) );
+
+    #endif
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+/// @brief Write the pixel buffer to a frame on the chip.
+/// @param framenumber The number of the frame to write to. 0-7.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::pixelBufferWriteAllToFrame( uint8_t framenumber ) {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_WRITE_ALL );
+
+    // send state, blink and pwm together, so runs can carry on across them.
+    return _frameImageWrite( framenumber , PIMORONI_11X7MATRIX_BUFFER_STATE | PIMORONI_11X7MATRIX_BUFFER_BLINK | PIMORONI_11X7MATRIX_BUFFER_PWM );
+
+}
+
+
+
+
+
+
+
+/// @brief Write the pixel state buffer to a frame on the chip.
+/// @param framenubmer The number of the frame to write. 0-7.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::pixelBufferStateWriteToFrame( uint8_t framenumber ) {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_WRITE_STATE );
+
+    return _pixelBufferStateFastWrite( framenumber );
+    
+}
+
+/// @brief Write the pixel blink state buffer to a frame on the chip.
+/// @param framenumber The number of the frame to write to. 0-7.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::pixelBufferBlinkStateWriteToFrame( uint8_t framenumber ) {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_WRITE_BLINK );
+
+    return _pixelBufferBlinkStateFastWrite( framenumber );
+
+}
+
+/// @brief Write the pixel pwm state buffer to a frame on the chip.
+/// @param framenumber The number of the frame to write to. 0-7.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::pixelBufferpwmStateWriteToFrame( uint8_t framenumber ) {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_WRITE_PWM );
+
+    return _pixelBufferpwmStateFastWrite( framenumber );
+
+}
+
+
+
+
+/// @brief Start double buffering between two hardware frames.
+/// @param frontframe The frame to show now. 0-7.
+/// @param backframe The frame to draw into first. 0-7, not the same as frontframe.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::doubleBufferBegin( uint8_t frontframe , uint8_t backframe ) {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_DOUBLE_BUFFER );
+
+    frontframe &= 0b00000111;
+    backframe &= 0b00000111;
+
+    // the same frame twice would just be drawing on display, so use its neighbour
+    if ( backframe == frontframe ) { backframe = frontframe ^ 0b00000001; }
+
+    _frontframe = frontframe;
+    _backframe = backframe;
+    _doublebuffered = 1;
+
+    // the front frame has to be the one showing, or present() could draw on display
+    if ( ( _controlregister[ IS31FL3731_ADDRESS_PICTURE_DISPLAY_REG ] == _frontframe ) && !( ( _controlregisterdirty >> IS31FL3731_ADDRESS_PICTURE_DISPLAY_REG ) & 0x0001 ) ) { return PIMORONI_11X7MATRIX_OK; }
+
+    return _displayFrameWrite( _frontframe );
+
+}
+
+
+/// @brief Stop double buffering.  Whatever is on display stays there.
+template< class Transport >
+void Pimoroni_11x7matrixT< Transport >::doubleBufferEnd() {
+
+    _doublebuffered = 0;
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+/// @brief Upload the pixel buffers to the back frame, then show it with one display pointer write.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::present() {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_PRESENT );
+
+    uint8_t buffers = PIMORONI_11X7MATRIX_BUFFER_STATE | PIMORONI_11X7MATRIX_BUFFER_BLINK | PIMORONI_11X7MATRIX_BUFFER_PWM;
+
+    // nothing hidden to draw into, so this is just a write to the frame on display
+    if ( !_doublebuffered ) { return _frameImageWrite( backFrameGet() , buffers ); }
+
+    // the dirty flags already know what the back frame is missing since it was last sent
+    uint8_t status = _frameImageWrite( _backframe , buffers );
+
+    // a half sent frame must never be shown
+    if ( status ) { return status; }
+
+    // straight to the chip, even inside beginUpdate(), the swap below has to match what is showing
+    status = _displayFrameWrite( _backframe );
+    if ( status ) { return status; }
+
+    // swap over, the one that was showing is now the one to draw into
+    uint8_t frame = _frontframe;
+    _frontframe = _backframe;
+    _backframe = frame;
+
+    return PIMORONI_11X7MATRIX_OK;
+
+}
+
+
+/// @brief Gets the frame present() will upload to next.
+/// @return The back frame while double buffering, otherwise the frame on display. 0-7.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::backFrameGet() {
+
+    if ( _doublebuffered ) { return _backframe; }
+
+    return _controlregister[ IS31FL3731_ADDRESS_PICTURE_DISPLAY_REG ] & 0b00000111;
+
+}
+
+
+
+
+/// @brief Start brightness only mode, where the pwm value alone says whether a pixel is lit.
+template< class Transport >
+void Pimoroni_11x7matrixT< Transport >::brightnessOnlyBegin() {
+
+    _brightnessonly = 1;
+
+    // keep the picture, then every state bit goes on and stays on
+    _brightnessOnlyFold();
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+/// @brief Stop brightness only mode.  Each state bit is set from whether its pwm is above 0.
+template< class Transport >
+void Pimoroni_11x7matrixT< Transport >::brightnessOnlyEnd() {
+
+    if ( !_brightnessonly ) { return; }
+
+    _brightnessonly = 0;
+
+    for ( uint8_t chipindex = 0 ; chipindex < 11 ; chipindex++ ) {
+
+        uint8_t tempbyte = 0x00;
+
+        for ( uint8_t y = 0 ; y < 7 ; y++ ) {
+
+            if ( _pwmBufferGet( chipindex , y ) ) { tempbyte |= ( 0b00000001 << y ); }
+
+        }
+
+        _bitBufferColumnSet( _ledstate , _ledstatedirty , chipindex , tempbyte );
+
+    }
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+/// @brief Checks if brightness only mode is on.
+/// @return 1 if it is, 0 if not.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::brightnessOnlyGet() {
+
+    return _brightnessonly;
+
+}
+
+
+
+
+/// @brief Put every pwm value through a gamma curve as it is sent.
+/// @param state 1 for on, 0 for off.
+template< class Transport >
+void Pimoroni_11x7matrixT< Transport >::gammaEnableSet( uint8_t state ) {
+
+    state = ( state != 0 );
+
+    if ( _gamma == state ) { return; }
+
+    _gamma = state;
+
+    // every frame now holds the wrong pwm
+    for ( uint8_t chipindex = 0 ; chipindex < 11 ; chipindex++ ) { _ledpwmstatedirty[ chipindex ] = 0xFF; }
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+/// @brief Checks if the gamma curve is on.
+/// @return 1 if it is, 0 if not.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::gammaEnableGet() {
+
+    return _gamma;
+
+}
+
+
+/// @brief Scale every pwm value as it is sent, before the gamma curve.
+/// @param brightness 0-255. 255 sends the values as they are.
+template< class Transport >
+void Pimoroni_11x7matrixT< Transport >::masterBrightnessSet( uint8_t brightness ) {
+
+    if ( _masterbrightness == brightness ) { return; }
+
+    _masterbrightness = brightness;
+
+    // every frame now holds the wrong pwm
+    for ( uint8_t chipindex = 0 ; chipindex < 11 ; chipindex++ ) { _ledpwmstatedirty[ chipindex ] = 0xFF; }
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+/// @brief Gets the master brightness.
+/// @return 0-255.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::masterBrightnessGet() {
+
+    return _masterbrightness;
+
+}
+
+
+/// @brief Gets what the chip is sent for a pwm value, after the master brightness and gamma.
+/// @param data The pwm value as stored.
+/// @return The pwm value to send.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::_pwmOutput( uint8_t data ) {
+
+    // 255 leaves it exactly as it was, 0 turns everything off
+    if ( _masterbrightness != 255 ) { data = ( (uint16_t)( data ) * ( _masterbrightness + 1 ) ) >> 8; }
+
+    if ( _gamma ) { data = pgm_read_byte( &pimoroni_11x7matrixGamma[ data ] ); }
+
+    return data;
+
+}
+
+
+/// @brief Sets a pixel on or off in brightness only mode, by its pwm value.
+/// @param chipindex The chip index of the pixel's column. 0-10.
+/// @param ypos The y position of the pixel.
+/// @param state 0 for off, anything else for on.
+template< class Transport >
+void Pimoroni_11x7matrixT< Transport >::_brightnessPixelSet( uint8_t chipindex , uint8_t ypos , uint8_t state ) {
+
+    // off is no brightness at all
+    if ( !state ) { _pwmBufferSet( chipindex , ypos , 0x00 ); return; }
+
+    // on keeps whatever brightness it has, unless it has none
+    if ( !_pwmBufferGet( chipindex , ypos ) ) { _pwmBufferSet( chipindex , ypos , 0xFF ); }
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+/// @brief Gets a column of on/off states, from the pwm values in brightness only mode.
+/// @param chipindex The chip index of the column. 0-10.
+/// @return The column, bit 0 at the bottom of the chip.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::_stateColumnGet( uint8_t chipindex ) {
+
+    if ( !_brightnessonly ) { return _ledstate[ chipindex ]; }
+
+    uint8_t data = 0x00;
+
+    for ( uint8_t y = 0 ; y < 7 ; y++ ) {
+
+        if ( _pwmBufferGet( chipindex , y ) ) { data |= ( 0b00000001 << y ); }
+
+    }
+
+    return data;
+
+}
+
+
+/// @brief Stores a column of on/off states, through the pwm values in brightness only mode.
+/// @param chipindex The chip index of the column. 0-10.
+/// @param data The column, bit 0 at the bottom of the chip.
+template< class Transport >
+void Pimoroni_11x7matrixT< Transport >::_stateColumnSet( uint8_t chipindex , uint8_t data ) {
+
+    if ( !_brightnessonly ) { _bitBufferColumnSet( _ledstate , _ledstatedirty , chipindex , data ); return; }
+
+    // only the pixels that change are touched, so a lit one keeps its brightness
+    uint8_t changed = _stateColumnGet( chipindex ) ^ data;
+
+    for ( uint8_t y = 0 ; y < 7 ; y++ ) {
+
+        if ( ( changed >> y ) & 0b00000001 ) { _brightnessPixelSet( chipindex , y , ( data >> y ) & 0b00000001 ); }
+
+    }
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+/// @brief Folds the state buffer into the pwm buffer, zeroing the pwm of every pixel that is off, then turns every state bit on.
+template< class Transport >
+void Pimoroni_11x7matrixT< Transport >::_brightnessOnlyFold() {
+
+    for ( uint8_t chipindex = 0 ; chipindex < 11 ; chipindex++ ) {
+
+        for ( uint8_t y = 0 ; y < 7 ; y++ ) {
+
+            if ( !( ( _ledstate[ chipindex ] >> y ) & 0b00000001 ) ) { _pwmBufferSet( chipindex , y , 0x00 ); }
+
+        }
+
+        // only goes out to each frame the once, since nothing changes it again
+        _bitBufferColumnSet( _ledstate , _ledstatedirty , chipindex , 0x7F );
+
+    }
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+
+
+
+/// @brief Read a frame back from the chip, undoing the column interleave.
+/// @param framenumber The number of the frame to read. 0-7.
+/// @param buffer Where to put the frame.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::frameReadback( uint8_t framenumber , Pimoroni_11x7matrixFrameBuffer *buffer ) {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_FRAME_READ );
+
+    return _frameImageRead( framenumber , buffer );
+
+}
+
+
+/// @brief Read a frame back from the chip into the pixel buffers.
+/// @param framenumber The number of the frame to read. 0-7.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::pixelBufferReadFromFrame( uint8_t framenumber ) {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_FRAME_READ );
+
+    Pimoroni_11x7matrixFrameBuffer buffer;
+
+    uint8_t status = _frameImageRead( framenumber , &buffer );
+    if ( status ) { return status; }
+
+    // the bit for this frame in the dirty flags
+    uint8_t framebit = ( 0b00000001 << framenumber );
+
+    for ( uint8_t x = 0 ; x < 11 ; x++ ) {
+
+        uint8_t chipindex = _columnToChipIndex[ x ];
+
+        // anything that changes now needs sending to the other frames
+        _bitBufferColumnSet( _ledstate , _ledstatedirty , chipindex , buffer.state[ x ] );
+        _bitBufferColumnSet( _ledblinkstate , _ledblinkstatedirty , chipindex , buffer.blink[ x ] );
+
+        uint8_t pwmexact = 1;
+
+        for ( uint8_t y = 0 ; y < 7 ; y++ ) {
+
+            _pwmBufferSet( chipindex , y , buffer.pwm[ x ][ y ] );
+
+            // a packed buffer may have had to round it
+            if ( _pwmOutput( _pwmBufferGet( chipindex , y ) ) != buffer.pwm[ x ][ y ] ) { pwmexact = 0; }
+
+        }
+
+        // but this frame already holds it
+        _ledstatedirty[ chipindex ] &= ~framebit;
+        _ledblinkstatedirty[ chipindex ] &= ~framebit;
+        if ( pwmexact ) { _ledpwmstatedirty[ chipindex ] &= ~framebit; }
+
+    }
+
+    // anything the frame had turned off is turned off by its pwm instead
+    if ( _brightnessonly ) { _brightnessOnlyFold(); }
+
+    // all done, return to caller
+    return PIMORONI_11X7MATRIX_OK;
+
+}
+
+
+/// @brief Check a frame on the chip matches the pixel buffers.
+/// @param framenumber The number of the frame to check. 0-7.
+/// @return PIMORONI_11X7MATRIX_OK if it matches, PIMORONI_11X7MATRIX_ERROR_VERIFY if not, or a bus error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::pixelBufferVerifyFrame( uint8_t framenumber ) {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_FRAME_VERIFY );
+
+    Pimoroni_11x7matrixFrameBuffer buffer;
+
+    uint8_t status = _frameImageRead( framenumber , &buffer );
+    if ( status ) { return status; }
+
+    for ( uint8_t x = 0 ; x < 11 ; x++ ) {
+
+        uint8_t chipindex = _columnToChipIndex[ x ];
+
+        if ( buffer.state[ x ] != _ledstate[ chipindex ] ) { return PIMORONI_11X7MATRIX_ERROR_VERIFY; }
+        if ( buffer.blink[ x ] != _ledblinkstate[ chipindex ] ) { return PIMORONI_11X7MATRIX_ERROR_VERIFY; }
+
+        for ( uint8_t y = 0 ; y < 7 ; y++ ) {
+
+            if ( buffer.pwm[ x ][ y ] != _pwmOutput( _pwmBufferGet( chipindex , y ) ) ) { return PIMORONI_11X7MATRIX_ERROR_VERIFY; }
+
+        }
+
+    }
+
+    // all done, return to caller
+    return PIMORONI_11X7MATRIX_OK;
+
+}
+
+
+/// @brief Read the control registers back from the chip into the shadow copy.
+/// Changes waiting for commit() are kept. The frame state register 0x07 is left alone, so a pending
+/// frame interrupt is still there for frameDisplayInterruptGet().
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::controlRegisterReadback() {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_CONTROL_READ );
+
+    // hang on to anything waiting for commit()
+    uint8_t pending[ IS31FL3731_CONTROL_REGISTER_COUNT ];
+    memcpy( pending , _controlregister , IS31FL3731_CONTROL_REGISTER_COUNT );
+
+    uint8_t status = _controlRegisterCacheLoad();
+
+    // put the waiting changes back over the top, even if the read failed part way
+    for ( uint8_t address = 0 ; address < IS31FL3731_CONTROL_REGISTER_COUNT ; address++ ) {
+
+        if ( ( _controlregisterdirty >> address ) & 0x0001 ) { _controlregister[ address ] = pending[ address ]; }
+
+    }
+
+    return status;
+
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+/// @brief Marks the whole pixel buffer as changed for every frame, so the next writes send everything.
+template< class Transport >
+void Pimoroni_11x7matrixT< Transport >::pixelBufferInvalidate() {
+
+    // for each column of pixel buffers
+    for ( uint8_t x = 0 ; x < 11 ; x++ ) {
+
+        // every frame needs this column
+        _ledstatedirty[ x ] = 0xFF;
+        _ledblinkstatedirty[ x ] = 0xFF;
+        _ledpwmstatedirty[ x ] = 0xFF;
+
+    }
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+
+
+/// @brief Sets the pixel buffers for state, blink and pwm to all zero.
+template< class Transport >
+void Pimoroni_11x7matrixT< Transport >::pixelBufferClearAll() {
+
+    // for each column of pixel buffers
+    for ( uint8_t x = 0 ; x < 11 ; x++ ) {
+
+        // set the whole row of _ledstate to zero, or all on in brightness only mode.
+        _bitBufferColumnSet( _ledstate , _ledstatedirty , x , _brightnessonly ? 0x7F : 0x00 );
+
+        // set the whole row of _ledblinkstate to zero.
+        _bitBufferColumnSet( _ledblinkstate , _ledblinkstatedirty , x , 0x00 );
+
+        // for each pwm value in the row
+        for ( uint8_t y = 0 ; y < 7 ; y++ ) {
+
+            // set it to zero.
+            _pwmBufferSet( x , y , 0x00 );
+
+        }
+
+    }
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+
+
+/// @brief Sets the pixel buffer for state to all zero.
+template< class Transport >
+void Pimoroni_11x7matrixT< Transport >::pixelBufferStateClear() {
+
+    // the state stays all on, the pwm turns them off
+    if ( _brightnessonly ) { pixelBufferpwmStateClear(); return; }
+
+    // for each element in the _ledstate array...
+    for ( uint8_t i = 0 ; i < 11 ; i++ ) {
+
+        // set it to zero.
+        _bitBufferColumnSet( _ledstate , _ledstatedirty , i , 0x00 );
+
+    }
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+
+/// @brief Sets the pixel buffer for blink state to all zero.
+template< class Transport >
+void Pimoroni_11x7matrixT< Transport >::pixelBufferBlinkStateClear() {
+
+    // for each element in the _ledblinkstate array...
+    for ( uint8_t i = 0 ; i < 11 ; i++ ) {
+
+        // set it to zero
+        _bitBufferColumnSet( _ledblinkstate , _ledblinkstatedirty , i , 0x00 );
+
+    }
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+
+/// @brief Sets the pixel buffer for pwm value to all zero.
+template< class Transport >
+void Pimoroni_11x7matrixT< Transport >::pixelBufferpwmStateClear() {
+
+    // for each column in the _ledpwmstate array...
+    for ( uint8_t x = 0 ; x < 11 ; x++ ) {
+
+        // for each row in the _ledpwmstate array...
+        for ( uint8_t y = 0 ; y < 7 ; y++ ) {
+
+            // set it to zero.
+            _pwmBufferSet( x , y , 0x00 );
+
+        }
+
+    }
+
+    // all done, return to caller.
+    return;
+}
+
+
+
+
+
+
+
+/// @brief Set all pixels state to the given value.
+/// @param data 0 = off, 1 = on.
+template< class Transport >
+void Pimoroni_11x7matrixT< Transport >::pixelBufferStateFill( uint8_t data ) {
+
+    if ( _brightnessonly ) {
+
+        for ( uint8_t i = 0 ; i < 11 ; i++ ) {
+
+            for ( uint8_t y = 0 ; y < 7 ; y++ ) { _brightnessPixelSet( i , y , data ); }
+
+        }
+
+        // all done, return to caller.
+        return;
+
+    }
+
+    // for each element in the _ledstate array...
+    for ( uint8_t i = 0 ; i < 11 ; i++ ) {
+
+        // set it to zero.
+        _bitBufferColumnSet( _ledstate , _ledstatedirty , i , data );
+
+    }
+
+    // all done, return to caller.
+    return;
+
+}
+
+/// @brief Set all pixels blink state to the given value
+/// @param data 0 = off, 1 = on.
+template< class Transport >
+void Pimoroni_11x7matrixT< Transport >::pixelBufferBlinkStateFill( uint8_t data ) {
+    
+    // for each element in the _ledstate array...
+    for ( uint8_t i = 0 ; i < 11 ; i++ ) {
+
+        // set it to zero.
+        _bitBufferColumnSet( _ledblinkstate , _ledblinkstatedirty , i , data );
+
+    }
+
+    // all done, return to caller.
+    return;
+
+}
+
+/// @brief Set all pixels pwm value to the given value.
+/// @param data 0-255. 0 is fully off, 255 is fully on.
+template< class Transport >
+void Pimoroni_11x7matrixT< Transport >::pixelBufferpwmStateFill( uint8_t data ) {
+    // for each column in the _ledpwmstate array...
+    for ( uint8_t x = 0 ; x < 11 ; x++ ) {
+
+        // for each row in the _ledpwmstate array...
+        for ( uint8_t y = 0 ; y < 7 ; y++ ) {
+
+            // set it to the new value.
+            _pwmBufferSet( x , y , data );
+
+        }
+
+    }
+
+    // all done, return to caller.
+    return;
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+/// @brief Set which way up the board is mounted.
+/// @param orientation PIMORONI_11X7MATRIX_ROTATE_0 or PIMORONI_11X7MATRIX_ROTATE_180, or'd with PIMORONI_11X7MATRIX_FLIP_X and PIMORONI_11X7MATRIX_FLIP_Y.
+/// @return 1 if it was set, 0 if it was a quarter turn.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::orientationSet( uint8_t orientation ) {
+
+    // 7 across won't go in 11
+    if ( orientation & PIMORONI_11X7MATRIX_ROTATE_90 ) { return 0; }
+
+    _orientation = orientation;
+
+    // turning 180 is flipping both ways
+    uint8_t half = ( ( orientation & 0b00000011 ) == PIMORONI_11X7MATRIX_ROTATE_180 );
+
+    // pick the tables once here, so setting a pixel is two lookups whichever way up it is
+    _columnmap = _orientColumn[ half ^ ( ( orientation & PIMORONI_11X7MATRIX_FLIP_X ) != 0 ) ];
+    _rowmap = _orientRow[ half ^ ( ( orientation & PIMORONI_11X7MATRIX_FLIP_Y ) != 0 ) ];
+
+    return 1;
+
+}
+
+
+/// @brief Gets which way up the board is mounted.
+/// @return The orientation given to orientationSet().
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::orientationGet() {
+
+    return _orientation;
+
+}
+
+
+/// @brief Turns a column mask the way up orientationSet() says.
+/// @param mask The mask, bit 0 at the bottom as the caller sees it.
+/// @return The mask, bit 0 at the bottom of the chip's column.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::_columnMaskOrient( uint8_t mask ) {
+
+    mask &= 0b01111111;
+
+    // the right way up already
+    if ( !_rowmap[ 0 ] ) { return mask; }
+
+    // upside down, so the bits go the other way
+    uint8_t flipped = 0x00;
+
+    for ( uint8_t y = 0 ; y < 7 ; y++ ) {
+
+        if ( ( mask >> y ) & 0b00000001 ) { flipped |= ( 0b01000000 >> y ); }
+
+    }
+
+    return flipped;
+
+}
+
+
+
+
+/// @brief Sets a pixel to on or off in the pixel buffer.
+/// @param xpos The x position, with zero at the bottom left.
+/// @param ypos The y position, with the zero at the bottom left.
+/// @param state The state, 1 for on, 0 for off.
+template< class Transport >
+void Pimoroni_11x7matrixT< Transport >::pixelSet( uint8_t xpos , uint8_t ypos , uint8_t state ) {
+
+    // the column is kept where the chip has it
+    uint8_t chipindex = _columnmap[ xpos ];
+
+    // the state stays all on, the pwm does the work
+    if ( _brightnessonly ) { _brightnessPixelSet( chipindex , _rowmap[ ypos ] , state ); return; }
+
+    // start from the current column
+    uint8_t tempbyte = _ledstate[ chipindex ];
+
+    // check if we are turning the bit on, or off.
+    if ( state ) {
+
+        // set bit to 1
+        tempbyte |= ( 0b00000001 << _rowmap[ ypos ] );
+
+    }
+    else {
+
+        // set bit to 0
+        tempbyte &= ~( 0b00000001 << _rowmap[ ypos ] );
+    }
+
+    // store it, marking the column dirty if it changed.
+    _bitBufferColumnSet( _ledstate , _ledstatedirty , chipindex , tempbyte );
+
+    // all done, return to caller.
+    return;
+}
+
+
+
+/// @brief Gets the value of a pixel from the pixel buffer.
+/// @param xpos The x position, with zero at the bottom left.
+/// @param ypos The y position, with zero at the bottom left.
+/// @return The state of the pixel as a uint8_t.  0 for off, 1 for on.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::pixelGet( uint8_t xpos , uint8_t ypos ) {
+
+    // lit by its pwm alone
+    if ( _brightnessonly ) { return ( _pwmBufferGet( _columnmap[ xpos ] , _rowmap[ ypos ] ) != 0 ); }
+
+    // return the bit for this pixel as a uint8_t.
+    return (uint8_t)( ( _ledstate[ _columnmap[ xpos ] ] >> _rowmap[ ypos ] ) & 0b00000001 );
+
+}
+
+
+
+
+
+/// @brief Set the blink flag for a pixel on or off in the pixel buffer.
+/// @param xpos The x position, with zero at the bottom left.
+/// @param ypos The y position, with zero at the bottom left.
+/// @param state The state of the blink flag as a uint8_t.  0 for off, 1 for on.
+template< class Transport >
+void Pimoroni_11x7matrixT< Transport >::pixelBlinkSet( uint8_t xpos , uint8_t ypos , uint8_t state ){
+
+    // the column is kept where the chip has it
+    uint8_t chipindex = _columnmap[ xpos ];
+
+    // start from the current column
+    uint8_t tempbyte = _ledblinkstate[ chipindex ];
+
+    // check if we are turning the bit on, or off.
+    if ( state ) {
+
+        // set bit to 1
+        tempbyte |= ( 0b00000001 << _rowmap[ ypos ] );
+
+    }
+    else {
+
+        // set bit to 0
+        tempbyte &= ~( 0b00000001 << _rowmap[ ypos ] );
+    }
+
+    // store it, marking the column dirty if it changed.
+    _bitBufferColumnSet( _ledblinkstate , _ledblinkstatedirty , chipindex , tempbyte );
+
+    // all done, return to caller.
+    return;
+
+}
+
+/// @brief Get the state of a pixels blink flag from the pixel buffer.
+/// @param xpos The x position, with zero at the bottom left.
+/// @param ypos The y position, with zero at the bottom left.
+/// @return The state of the pixel as a uint8_t.  0 for off, 1 for on.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::pixelBlinkGet( uint8_t xpos , uint8_t ypos ) {
+    
+    // return the bit for this pixel as a uint8_t.
+    return (uint8_t)( ( _ledblinkstate[ _columnmap[ xpos ] ] >> _rowmap[ ypos ] ) & 0b00000001 );
+
+}
+
+
+
+
+
+/// @brief Set the pwm value for a pixel in the pixel buffer
+/// @param xpos The x position of the pixel, with zero at the bottom left.
+/// @param ypos The y position of the pixel, with zero at the bottom left.
+/// @param state The pwm value to set, as a uint8_t.  0 is full off, 255 is full on.
+template< class Transport >
+void Pimoroni_11x7matrixT< Transport >::pixelpwmSet( uint8_t xpos , uint8_t ypos , uint8_t state ) {
+
+    // set the pixel pwm value in the array, in the column where the chip has it
+    _pwmBufferSet( _columnmap[ xpos ] , _rowmap[ ypos ] , state );
+
+    // all done, return to caller.
+    return;
+
+}
+
+/// @brief Get the pwm value for a pixel from the pixel buffer.
+/// @param xpos The x position of the pixel, with zero at the bottom left.
+/// @param ypos The y position of the pixel, with zero at the bottom left.
+/// @return The pwm value of the pixel as a uint8_t.  0 is fully off, 255 is fully on.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::pixelpwmGet( uint8_t xpos , uint8_t ypos ) {
+
+    // return the byte for this pixel as a uint8_t.
+    return _pwmBufferGet( _columnmap[ xpos ] , _rowmap[ ypos ] );
+
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+// register config functions
+
+
+
+
+/// @brief Start collecting control register changes instead of writing them straight away.
+template< class Transport >
+void Pimoroni_11x7matrixT< Transport >::beginUpdate() {
+
+    // count how deep we are, so updates can nest
+    _controlupdatedepth++;
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+/// @brief Send every control register changed since beginUpdate() in one auto increment write.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::commit() {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_COMMIT );
+
+    // only the outermost commit talks to the chip.
+    // outside an update there is nothing to wait for, so anything a failed commit or write left behind goes now.
+    if ( _controlupdatedepth ) {
+
+        _controlupdatedepth--;
+        if ( _controlupdatedepth ) { return PIMORONI_11X7MATRIX_OK; }
+
+    }
+
+    // nothing changed, so nothing to send
+    if ( !_controlregisterdirty ) { return PIMORONI_11X7MATRIX_OK; }
+
+    // find the first and last register that changed
+    uint8_t firstregister = 0;
+    while ( !( _controlregisterdirty & ( (uint16_t)( 0x0001 ) << firstregister ) ) ) { firstregister++; }
+
+    uint8_t lastregister = IS31FL3731_CONTROL_REGISTER_COUNT - 1;
+    while ( !( _controlregisterdirty & ( (uint16_t)( 0x0001 ) << lastregister ) ) ) { lastregister--; }
+
+    // if this fails the changes stay dirty, so the next commit() sends them again.
+    uint8_t status = _switchFrame( IS31FL3731_PAGE_CONTROL );
+    if ( status ) { return status; }
+
+    // say hello to the chip again...
+    _transport.beginTransmission( _i2c_address );
+
+    // send the first address, the chip auto increments from here
+    _busWrite( firstregister );
+
+    // send the whole range from the shadow copy.
+    // anything in between that did not change is rewritten with the same value,
+    // and the read only frame state register ignores the write.
+    for ( uint8_t i = firstregister ; i <= lastregister ; i++ ) {
+
+        _busWrite( _controlregister[ i ] );
+
+    }
+
+    // say goodbye
+    status = _busEndTransmission();
+    if ( status ) { return status; }
+
+    // everything is on the chip now
+    _controlregisterdirty = 0x0000;
+
+    // all done, return to caller.
+    return PIMORONI_11X7MATRIX_OK;
+
+}
+
+
+
+
+
+// 0x00 configuration register
+
+
+
+/// @brief Sets the display mode on the chip.
+/// @param mode The mode number to set. 0b00 = picture mode, 0b01 = auto frame play, 0b1x = audio frame play.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::displayModeSet( uint8_t mode ) {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_CONTROL_SET );
+
+    // fetch the current byte from the shadow copy
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_CONFIG_REG ];
+
+    // add in my data
+    tempbyte &= 0b11100111;
+    tempbyte |= ( mode << 3 );
+
+    // send it, and tell the caller how it went.
+    return _controlRegisterWrite( IS31FL3731_ADDRESS_CONFIG_REG , tempbyte );
+
+}
+
+
+
+
+
+
+
+/// @brief Gets the display mode from the chip.
+/// @return The current display mode number as a uint8_t. 0b00 = picture mode, 0b01 = auto frame play, 0b1x = audio frame play.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::displayModeGet() {
+
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_CONFIG_REG ];
+
+    // get our data out
+    tempbyte &= 0b00011000;
+    
+    return (uint8_t)( tempbyte >> 3 );
+
+}
+
+
+
+
+/// @brief Sets the start frame for autoplay
+/// @param startframe The number of the frame to syart autoplay on. 0-7.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::autoplayFrameStartSet( uint8_t startframe ) {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_CONTROL_SET );
+
+    // fetch the current byte from the shadow copy
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_CONFIG_REG ];
+
+    // add in my data
+    tempbyte &= 0b11111000;
+    tempbyte |= ( startframe & 0b00000111 );
+
+    // send it, and tell the caller how it went.
+    return _controlRegisterWrite( IS31FL3731_ADDRESS_CONFIG_REG , tempbyte );
+
+}
+
+/// @brief Gets the start frame for autoplay
+/// @return The number of the frame to start autoplay on as a uint8_t. 0-7.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::autoplayFrameStartGet() {
+
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_CONFIG_REG ];
+
+    // get our data out
+    tempbyte &= 0b00000111;
+    
+    return tempbyte;
+
+}
+
+
+
+
+
+// 0x01 Picture Display Register
+
+
+/// @brief Set the chips frame display pointer
+/// @param framenumber The number of the frame to display. 0-7.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::frameDisplayPointerSet( uint8_t framenumber ) {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_CONTROL_SET );
+
+    return _controlRegisterWrite( IS31FL3731_ADDRESS_PICTURE_DISPLAY_REG , framenumber );
+}
+
+
+/// @brief Fetches the current frame display pointer from the chip.
+/// @return The current frame display pointer as a uint8_t. 0-7.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::frameDisplayPointerGet() {
+    return _controlregister[ IS31FL3731_ADDRESS_PICTURE_DISPLAY_REG ];
+}
+
+
+
+
+
+
+
+// 0x02 Autoplay Control Register 1
+
+/// @brief Sets the number of loops to play in Auto frame Play mode.
+/// @param numberofloops The number of loops to play. 0 = infinite, 1-7 plays that many loops.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::autoplayNumberOfLoopsSet( uint8_t numberofloops ) {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_CONTROL_SET );
+
+    // fetch the current byte from the shadow copy
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_AUTOPLAY_CONTROL_ONE_REG ];
+
+    // add in my data
+    tempbyte &= 0b10001111;
+    tempbyte |= ( ( numberofloops & 0b00000111 ) << 4);
+
+    // send it, and tell the caller how it went.
+    return _controlRegisterWrite( IS31FL3731_ADDRESS_AUTOPLAY_CONTROL_ONE_REG , tempbyte );
+}
+
+/// @brief Gets the number of loops to play in Auto Frame Play mode.
+/// @return The number of loops to play.  0 = infinite, 1-7 plays that many loops.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::autoplayNumberOfLoopsGet() {
+
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_AUTOPLAY_CONTROL_ONE_REG ];
+
+    // get our data out
+    tempbyte &= 0b01110000;
+    
+    return ( tempbyte >> 4 );
+}
+
+
+
+
+/// @brief Sets the number of frames to play in Auto Frame Play mode.
+/// @param  numberofframes The number of frames to play. 0 = all frames, 1-7 = that many frames.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::autoplayNumberOfFramesPlayingSet( uint8_t numberofframes ) {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_CONTROL_SET );
+
+    // fetch the current byte from the shadow copy
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_AUTOPLAY_CONTROL_ONE_REG ];
+
+    // add in my data
+    tempbyte &= 0b11111000;
+    tempbyte |= ( numberofframes & 0b00000111 );
+
+    // send it, and tell the caller how it went.
+    return _controlRegisterWrite( IS31FL3731_ADDRESS_AUTOPLAY_CONTROL_ONE_REG , tempbyte );
+}
+
+/// @brief Gets the number of frames to play in an Auto Frame Play mode.
+/// @return The number of frames to play as a uint8_t. 0 = all framed, 1-7 = that many frames.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::autoplayNumberOfFramesPlayingGet() {
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_AUTOPLAY_CONTROL_ONE_REG ];
+
+    // get our data out
+    tempbyte &= 0b00000111;
+    
+    return tempbyte;
+}
+
+
+
+
+
+
+
+
+
+
+
+// 0x03 Autoplay Control Register 2
+
+/// @brief Sets the frame delay time for Auto Frame Play mode.
+/// @param framedelaytime The time each frame should be shown.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::autoplayFrameDelayTimeSet( uint8_t framedelaytime ) {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_CONTROL_SET );
+
+    // fetch the current byte from the shadow copy
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_AUTOPLAY_CONTROL_TWO_REG ];
+
+    // add in my data
+    tempbyte &= 0b11000000;
+    tempbyte |= ( framedelaytime & 0b00111111 );
+
+    // send it, and tell the caller how it went.
+    return _controlRegisterWrite( IS31FL3731_ADDRESS_AUTOPLAY_CONTROL_TWO_REG , tempbyte );
+}
+
+
+/// @brief Gets the frame delay time for Auto Frame Play mode.
+/// @return The frame delay time as a uint8_t.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::autoplayFrameDelayTimeGet() {
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_AUTOPLAY_CONTROL_TWO_REG ];
+
+    // get our data out
+    tempbyte &= 0b00111111;
+    
+    return tempbyte;
+}
+
+
+
+
+
+
+
+
+
+
+
+
+// 0x05 Display Option Register
+
+/// @brief Sets the intensity control bit.
+/// @param intensitystate 0 = set the intensity of each frame independently.  1 = use frame 0 for all settings.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::intensityControlSet( uint8_t intensitystate ) {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_CONTROL_SET );
+
+    // fetch the current byte from the shadow copy
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_DISPLAY_OPTION_REG ];
+
+    // add in my data
+    tempbyte &= 0b11011111;
+    tempbyte |= ( intensitystate & 0b00000001 ) << 5;
+
+    // send it, and tell the caller how it went.
+    return _controlRegisterWrite( IS31FL3731_ADDRESS_DISPLAY_OPTION_REG , tempbyte );
+}
+
+/// @brief Gets the intensity control bit.
+/// @return The intensity control bit, as a uint8_1. 0 = set the intensity of each frame independently.  1 = use frame 0 for all settings.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::intensityControlGet() {
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_DISPLAY_OPTION_REG ];
+
+    // get our data out
+    tempbyte &= 0b00100000;
+    
+    return ( tempbyte >> 5 );
+}
+
+
+/// @brief Enable blinking!
+/// @param blinkstate The blink state. 0 for disabled, 1 for enabled.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::blinkEnableSet( uint8_t blinkstate ) {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_CONTROL_SET );
+
+    // fetch the current byte from the shadow copy
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_DISPLAY_OPTION_REG ];
+
+    // add in my data
+    tempbyte &= 0b11110111;
+    tempbyte |= ( ( blinkstate & 0b00000001 ) << 3 );
+
+    // send it, and tell the caller how it went.
+    return _controlRegisterWrite( IS31FL3731_ADDRESS_DISPLAY_OPTION_REG , tempbyte );
+}
+
+/// @brief Get the current blink state.
+/// @return The current blink enable state as a uint8_t. 0 for disabled, 1 for enabled.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::blinkEnableGet() {
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_DISPLAY_OPTION_REG ];
+
+    // get our data out
+    tempbyte &= 0b00001000;
+    
+    return ( tempbyte >> 3 );
+}
+
+/// @brief Sets the blink period time.
+/// @param  blinkperiodtime The amount of time to spend on each blink. 0-7 = bpt * 0.27s
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::blinkPeriodTimeSet( uint8_t blinkperiodtime ) {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_CONTROL_SET );
+
+    // fetch the current byte from the shadow copy
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_DISPLAY_OPTION_REG ];
+
+    // add in my data
+    tempbyte &= 0b11111000;
+    tempbyte |= ( blinkperiodtime & 0b00000111 );
+
+    // send it, and tell the caller how it went.
+    return _controlRegisterWrite( IS31FL3731_ADDRESS_DISPLAY_OPTION_REG , tempbyte );
+
+}
+
+/// @brief Gets the blink period time
+/// @return The blink period time multiplier, as a uint8_t.  0-7 = bpt * 0.27s
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::blinkPeriodTimeGet() {
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_DISPLAY_OPTION_REG ];
+
+    // get our data out
+    tempbyte &= 0b00000111;
+    
+    return tempbyte;
+}
+
+
+
+// 0x06 Audio Synchronisation Register.
+
+/// @brief Set the Audio Synchronisaton state.
+/// @param state The desired state as a uint8_t. 0 = disable, 1 = enable.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::audioSynchEnableSet( uint8_t state ) {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_CONTROL_SET );
+
+    // fetch the current byte from the shadow copy
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_AUDIO_SYNCH_REG ];
+
+    // add in my data
+    tempbyte &= 0b11111110;
+    tempbyte |= ( state & 0b00000001 );
+
+    // send it, and tell the caller how it went.
+    return _controlRegisterWrite( IS31FL3731_ADDRESS_AUDIO_SYNCH_REG , tempbyte );
+}
+
+/// @brief Get the Audio Synchronisation state.
+/// @return The desired state as a uint8_t.  0 = disabled, 1 = enabled.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::audioSynchEnableGet() {
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_AUDIO_SYNCH_REG ];
+
+    // get our data out
+    tempbyte &= 0b00000001;
+    
+    return tempbyte;
+}
+
+
+
+// 0x07 Frame Display State Register. ( read only )
+
+/// @brief Returns true when the Auto Frame Play process has finished.  Automatically cleared on read.
+/// @return 0 if not finished.  1 when finished.  Automatically cleared on read.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::frameDisplayInterruptGet() {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_FRAME_STATE_GET );
+
+    uint8_t tempbyte = 0x00;
+
+    // this one has to come from the chip, lastStatusGet() says if it worked.
+    _chipreadbyte( IS31FL3731_PAGE_CONTROL , IS31FL3731_ADDRESS_FRAME_STATE_REG , &tempbyte );
+
+    // get our data out
+    tempbyte &= 0b00010000;
+    
+    return ( tempbyte >> 4 );
+}
+
+/// @brief Gets the number of the frame currently displayed in Auto Frame Play mode.
+/// @return The frame number. 0-7.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::currentFrameDisplayGet() {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_FRAME_STATE_GET );
+
+    uint8_t tempbyte = 0x00;
+
+    // this one has to come from the chip, lastStatusGet() says if it worked.
+    _chipreadbyte( IS31FL3731_PAGE_CONTROL , IS31FL3731_ADDRESS_FRAME_STATE_REG , &tempbyte );
+
+    // get our data out
+    tempbyte &= 0b00000111;
+    
+    return tempbyte;
+}
+
+
+
+
+
+// 0x08 Breath Control Register 1
+
+/// @brief Sets the fade out time for breath control
+/// @param fadetime 0-7. interval 26ms.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::breathControlFadeOutTimeSet( uint8_t fadetime ) {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_CONTROL_SET );
+
+    // fetch the current byte from the shadow copy
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_BREATH_CONTROL_ONE_REG ];
+
+    // add in my data
+    tempbyte &= 0b10001111;
+    tempbyte |= ( ( fadetime & 0b00000111 ) << 4 );
+
+    // send it, and tell the caller how it went.
+    return _controlRegisterWrite( IS31FL3731_ADDRESS_BREATH_CONTROL_ONE_REG , tempbyte );
+}
+
+/// @brief Gets the fade out time for breath control.
+/// @return 0-7. interval 26ms.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::breathControlFadeOutTimeGet() {
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_BREATH_CONTROL_ONE_REG ];
+
+    // get our data out
+    tempbyte &= 0b01110000;
+    
+    return ( tempbyte >> 4 );
+}
+
+
+/// @brief Sets the fade in time for breath control.
+/// @param fadetime 0-7. interval 26ms.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::breathControlFadeInTimeSet( uint8_t fadetime ) {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_CONTROL_SET );
+
+    // fetch the current byte from the shadow copy
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_BREATH_CONTROL_ONE_REG ];
+
+    // add in my data
+    tempbyte &= 0b11111000;
+    tempbyte |= ( fadetime & 0b00000111 );
+
+    // send it, and tell the caller how it went.
+    return _controlRegisterWrite( IS31FL3731_ADDRESS_BREATH_CONTROL_ONE_REG , tempbyte );
+}
+
+/// @brief Gets the fade in time for breath control.
+/// @return 0-7. interval 26ms.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::breathControlFadeInTimeGet() {
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_BREATH_CONTROL_ONE_REG ];
+
+    // get our data out
+    tempbyte &= 0b00000111;
+    
+    return tempbyte;
+}
+
+
+
+
+
+// 0x09 Breath Control Register 2
+
+/// @brief Sets the enable flaf for the Breath Control system.
+/// @param state 0 = disable , 1 = enable.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::breathControlEnableSet( uint8_t state ) {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_CONTROL_SET );
+
+    // fetch the current byte from the shadow copy
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_BREATH_CONTROL_TWO_REG ];
+
+    // add in my data
+    tempbyte &= 0b11101111;
+    tempbyte |= ( ( state & 0b00000001 ) << 4 );
+
+    // send it, and tell the caller how it went.
+    return _controlRegisterWrite( IS31FL3731_ADDRESS_BREATH_CONTROL_TWO_REG , tempbyte );
+}
+
+/// @brief Gets the enable flag for the Breath Control system.
+/// @return 0 = disable , 1 = enable.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::breathControlEnableGet() {
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_BREATH_CONTROL_TWO_REG ];
+
+    // get our data out
+    tempbyte &= 0b00010000;
+    
+    return ( tempbyte >> 4 );
+}
+
+
+/// @brief Sets the time off, between fade out and fade in, for the Breath Control system.
+/// @param fadetime 0-7. interval 3.5ms.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::breathControlExtinguishTimeSet( uint8_t fadetime ) {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_CONTROL_SET );
+
+    // fetch the current byte from the shadow copy
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_BREATH_CONTROL_TWO_REG ];
+
+    // add in my data
+    tempbyte &= 0b11111000;
+    tempbyte |= ( fadetime & 0b00000111 );
+
+    // send it, and tell the caller how it went.
+    return _controlRegisterWrite( IS31FL3731_ADDRESS_BREATH_CONTROL_TWO_REG , tempbyte );
+}
+
+/// @brief Gets the time off, between fade out and fade on, from the Breath Control system.
+/// @return 0-7. interval 3.5ms
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::breathControlExtinguishTimeGet() {
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_BREATH_CONTROL_TWO_REG ];
+
+    // get our data out
+    tempbyte &= 0b00000111;
+    
+    return tempbyte;
+}
+
+
+
+
+
+
+
+// 0x0A Shutdown Register.
+
+
+/// @brief Sets the software shutdown flag on the chip.
+/// @param state The state to set as a uint8_t. 0 = shutdown, 1 = normal operation.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::softwareShutdownSet( uint8_t state ) {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_CONTROL_SET );
+
+    // fetch the current byte from the shadow copy
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_SOFTWARESHUTDOWN_REG ];
+
+    // add in my data
+    tempbyte &= 0b11111110;
+    tempbyte |= ( state & 0b00000001 );
+
+    // send it, and tell the caller how it went.
+    return _controlRegisterWrite( IS31FL3731_ADDRESS_SOFTWARESHUTDOWN_REG , tempbyte );
+}
+
+/// @brief Gets the software shutdown flag from the chip.
+/// @return the flag as a uint8_t. 0 = shutdown, 1 = normal operation.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::softwareShutdownGet() {
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_SOFTWARESHUTDOWN_REG ];
+
+    // get our data out
+    tempbyte &= 0b00000001;
+    
+    return tempbyte;
+}
+
+
+
+
+// 0x0B AGC Control Register.
+
+/// @brief Set the AGC mode.
+/// @param state 0 = slow mode, 1 = fast mode.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::audioagcModeSet( uint8_t state ) {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_CONTROL_SET );
+
+    // fetch the current byte from the shadow copy
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_AGC_CONTROL_REG ];
+
+    // add in my data
+    tempbyte &= 0b11101111;
+    tempbyte |= ( ( state & 0b00000001 ) << 4 );
+
+    // send it, and tell the caller how it went.
+    return _controlRegisterWrite( IS31FL3731_ADDRESS_AGC_CONTROL_REG , tempbyte );
+}
+
+/// @brief Get the AGC mode.
+/// @return 0 = slow mode, 1 = fast mode.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::audioagcModeGet() {
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_AGC_CONTROL_REG ];
+
+    // get our data out
+    tempbyte &= 0b00010000;
+    
+    return ( tempbyte >> 4 );
+}
+
+/// @brief Set the enable flag for AGC.
+/// @param state 0 = disable, 1 = enable.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::audioagcEnableSet( uint8_t state ) {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_CONTROL_SET );
+
+    // fetch the current byte from the shadow copy
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_AGC_CONTROL_REG ];
+
+    // add in my data
+    tempbyte &= 0b11110111;
+    tempbyte |= ( ( state & 0b00000001 ) << 3 );
+
+    // send it, and tell the caller how it went.
+    return _controlRegisterWrite( IS31FL3731_ADDRESS_AGC_CONTROL_REG , tempbyte );
+}
+
+/// @brief Get the enable flag for AGC.
+/// @return 0 = disable, 1 = enable.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::audioagcEnableGet() {
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_AGC_CONTROL_REG ];
+
+    // get our data out
+    tempbyte &= 0b00001000;
+    
+    return ( tempbyte >> 3 );
+}
+
+/// @brief Sets the gain for the AGC
+/// @param gain 0-7, interval 3dB
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::audioagcGainSet( uint8_t gain ) {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_CONTROL_SET );
+
+    // fetch the current byte from the shadow copy
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_AGC_CONTROL_REG ];
+
+    // add in my data
+    tempbyte &= 0b11111000;
+    tempbyte |= ( gain & 0b00000111 );
+
+    // send it, and tell the caller how it went.
+    return _controlRegisterWrite( IS31FL3731_ADDRESS_AGC_CONTROL_REG , tempbyte );
+}
+
+/// @brief Gets the gain for AGC.
+/// @return 0-7, interval 3dB.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::audioagcGainGet() {
+    uint8_t tempbyte = _controlregister[ IS31FL3731_ADDRESS_AGC_CONTROL_REG ];
+
+    // get our data out
+    tempbyte &= 0b00000111;
+    
+    return tempbyte;
+}
+
+
+
+
+
+// 0x019 Audio ADC Rate Register
+
+/// @brief Sets the ADC sample rate.
+/// @param samplerate 0-255, interval 46us
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::audioadcSampleRateSet( uint8_t samplerate ) {
+
+    PIMORONI_11X7MATRIX_INSTRUMENT( PIMORONI_11X7MATRIX_API_CONTROL_SET );
+
+    // an actual 8 bit number?!
+    // send it, and tell the caller how it went.
+    return _controlRegisterWrite( IS31FL3731_ADDRESS_AUDIO_ADC_RATE_REG , samplerate );
+}
+
+/// @brief Gets the ADC sample rate.
+/// @return 0-255, interval 46us
+template< class Transport >
+uint8_t Pimoroni_11x7matrixT< Transport >::audioadcSampleRateGet() {
+    return _controlregister[ IS31FL3731_ADDRESS_AUDIO_ADC_RATE_REG ];
+
+}
+
+
+
+
+#endif
@@ -0,0 +1,11 @@
+// include my header
+#include <pimoroni_11x7matrix_player.h>
+
+// and the implementation
+#include <pimoroni_11x7matrix_player_impl.h>
+
+
+
+
+// build the player for the usual Wire bus
+template class Pimoroni_11x7matrixPlayerT< Pimoroni_11x7matrixWireTransport >;
@@ -0,0 +1,125 @@
+#ifndef PIMORONI_11X7MATRIX_PLAYER_HEADER_GUARD
+#define PIMORONI_11X7MATRIX_PLAYER_HEADER_GUARD
+
+
+// streaming animation player for the 11x7 matrix board by pimoroni
+
+// pull in the matrix driver
+#include <pimoroni_11x7matrix.h>
+
+
+
+
+/// @brief Draws one frame of an animation into the matrix pixel buffers.
+/// For a looping animation, draw index modulo the length and never return 0.
+/// Leave the pixel buffers alone when returning 0, the player copies the last frame from them.
+/// @param index The number of the frame in the animation, counting up from 0.
+/// @return 1 if the frame was drawn, 0 if the animation has ended.
+typedef uint8_t (*Pimoroni_11x7matrixFrameDraw)( uint32_t index );
+
+
+
+
+/// @brief Plays animations of any length at the chip's own frame rate.
+/// Use Pimoroni_11x7matrixPlayer with the usual Pimoroni_11x7matrix.
+/// The 8 hardware frames are a ring, auto frame play steps through them, and poll() draws the next
+/// animation frames into the ones it has already shown.  Only the columns that differ from what
+/// a frame held last time round are sent.  Call poll() at least once every 7 frame times, or the
+/// chip catches up with frames it has already shown.
+/// When the animation ends the chip is put back in picture mode, holding the last frame.
+/// From the end onwards the frames poll() frees up get copies of the last frame, so a late poll() never shows an old one.
+template< class Transport >
+class Pimoroni_11x7matrixPlayerT {
+
+
+    private:
+
+    /// @brief The matrix to play on.
+    Pimoroni_11x7matrixT< Transport > *_matrix;
+
+    /// @brief Draws the animation frames, or NULL when stopped.
+    Pimoroni_11x7matrixFrameDraw _draw;
+
+    /// @brief The next animation frame to draw.
+    uint32_t _nextindex;
+
+    /// @brief The next hardware frame to draw into. 0-7.
+    uint8_t _fillslot;
+
+    /// @brief The hardware frame on display when we last looked. 0-7.
+    uint8_t _shownslot;
+
+    /// @brief How many hardware frames have been shown and not drawn into again.
+    uint8_t _freeslots;
+
+    /// @brief The hardware frame holding the last animation frame, 0xFF if it has not been drawn yet.
+    uint8_t _endslot;
+
+    /// @brief 1 from start() until the animation ends or stop().
+    uint8_t _playing;
+
+    /// @brief How the last bus operation went.
+    uint8_t _status;
+
+    /// @brief Draw the next animation frame into a hardware frame.
+    /// @param slot The hardware frame. 0-7.
+    /// @return 1 if a frame was drawn, 0 if the animation has ended.  _status says how the write went.
+    uint8_t _slotFill( uint8_t slot );
+
+
+
+    public:
+
+    /// @brief Constructor for the player.
+    /// @param matrix The matrix to play on.  begin() it first.
+    Pimoroni_11x7matrixPlayerT( Pimoroni_11x7matrixT< Transport > &matrix );
+
+
+    /// @brief Fill the ring, then start auto frame play.
+    /// @param draw Draws each frame of the animation into the matrix pixel buffers.
+    /// @param framedelaytime How long each frame is shown, in steps of 11ms. 1-63, 0 is 64.
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t start( Pimoroni_11x7matrixFrameDraw draw , uint8_t framedelaytime );
+
+
+    /// @brief Check which frame the chip is showing, and draw into any it has finished with.
+    /// Costs one read of the frame state register, plus a frame write for each frame shown since last time.
+    /// @return 1 while the animation is playing, 0 once it has ended, been stopped, or hit a bus error.
+    uint8_t poll();
+
+
+    /// @brief Stop playing, holding whatever frame is on display in picture mode.
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t stop();
+
+
+    /// @brief Checks if an animation is playing.
+    /// @return 1 if playing, 0 if not.
+    uint8_t playing();
+
+
+    /// @brief Gets how many animation frames have been drawn so far.
+    /// @return The number of frames.
+    uint32_t framesDrawnGet();
+
+
+    /// @brief Gets how the last bus operation went.
+    /// @return PIMORONI_11X7MATRIX_OK, or an error code.
+    uint8_t statusGet();
+
+
+};
+
+
+
+
+// the player for the usual Wire bus, built once in pimoroni_11x7matrix_player.cpp.
+extern template class Pimoroni_11x7matrixPlayerT< Pimoroni_11x7matrixWireTransport >;
+typedef Pimoroni_11x7matrixPlayerT< Pimoroni_11x7matrixWireTransport > Pimoroni_11x7matrixPlayer;
+
+
+
+
+
+
+#endif
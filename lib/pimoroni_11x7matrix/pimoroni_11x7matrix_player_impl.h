@@ -0,0 +1,238 @@
+#ifndef PIMORONI_11X7MATRIX_PLAYER_IMPL_HEADER_GUARD
+#define PIMORONI_11X7MATRIX_PLAYER_IMPL_HEADER_GUARD
+
+
+// implementation of the streaming animation player template.
+// pimoroni_11x7matrix_player.cpp builds it for the default wire transport, include this yourself to build it for another transport.
+
+// include my header
+#include <pimoroni_11x7matrix_player.h>
+
+
+
+
+/// @brief Constructor for the player.
+/// @param matrix The matrix to play on.  begin() it first.
+template< class Transport >
+Pimoroni_11x7matrixPlayerT< Transport >::Pimoroni_11x7matrixPlayerT( Pimoroni_11x7matrixT< Transport > &matrix ) {
+
+    _matrix = &matrix;
+
+    // nothing playing yet
+    _draw = NULL;
+    _nextindex = 0;
+    _endslot = 0xFF;
+    _playing = 0;
+    _status = PIMORONI_11X7MATRIX_OK;
+
+}
+
+
+
+
+/// @brief Draw the next animation frame into a hardware frame.
+/// @param slot The hardware frame. 0-7.
+/// @return 1 if a frame was drawn, 0 if the animation has ended.  _status says how the write went.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixPlayerT< Transport >::_slotFill( uint8_t slot ) {
+
+    // already out of frames
+    if ( _endslot != 0xFF ) { return 0; }
+
+    // the one before this holds the last frame
+    if ( !_draw( _nextindex ) ) {
+
+        _endslot = ( slot - 1 ) & 0b00000111;
+        return 0;
+
+    }
+
+    _nextindex++;
+
+    // the dirty flags know what this frame held last time round, so only the difference goes out
+    _status = _matrix->pixelBufferWriteAllToFrame( slot );
+
+    return 1;
+
+}
+
+
+
+
+/// @brief Fill the ring, then start auto frame play.
+/// @param draw Draws each frame of the animation into the matrix pixel buffers.
+/// @param framedelaytime How long each frame is shown, in steps of 11ms. 1-63, 0 is 64.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixPlayerT< Transport >::start( Pimoroni_11x7matrixFrameDraw draw , uint8_t framedelaytime ) {
+
+    _draw = draw;
+    _nextindex = 0;
+    _endslot = 0xFF;
+    _playing = 0;
+
+    if ( !_draw ) { return PIMORONI_11X7MATRIX_OK; }
+
+    // hold still while the ring fills, or auto frame play would show it half drawn
+    _status = _matrix->displayModeSet( 0b00 );
+    if ( _status ) { return _status; }
+
+    uint8_t slots = 0;
+
+    while ( slots < 8 ) {
+
+        if ( !_slotFill( slots ) ) { break; }
+        if ( _status ) { return _status; }
+
+        slots++;
+
+    }
+
+    // an empty animation, nothing to play
+    if ( !slots ) {
+
+        _draw = NULL;
+        return PIMORONI_11X7MATRIX_OK;
+
+    }
+
+    // the ring starts full, the next frame goes where the first one is
+    _fillslot = 0;
+    _shownslot = 0;
+    _freeslots = 0;
+
+    // a short animation only plays the frames it has, all 8 is 0
+    _matrix->beginUpdate();
+
+    _matrix->autoplayFrameStartSet( 0 );
+    _matrix->autoplayNumberOfFramesPlayingSet( slots & 0b00000111 );
+    _matrix->autoplayNumberOfLoopsSet( 0 );
+    _matrix->autoplayFrameDelayTimeSet( framedelaytime );
+    _matrix->displayModeSet( 0b01 );
+
+    _status = _matrix->commit();
+    if ( _status ) { return _status; }
+
+    _playing = 1;
+
+    return PIMORONI_11X7MATRIX_OK;
+
+}
+
+
+
+
+/// @brief Check which frame the chip is showing, and draw into any it has finished with.
+/// @return 1 while the animation is playing, 0 once it has ended, been stopped, or hit a bus error.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixPlayerT< Transport >::poll() {
+
+    if ( !_playing ) { return 0; }
+
+    uint8_t currentslot = _matrix->currentFrameDisplayGet();
+
+    _status = _matrix->lastStatusGet();
+    if ( _status ) { _playing = 0; return 0; }
+
+    // how far the chip has moved on since we last looked
+    uint8_t advanced = ( currentslot - _shownslot ) & 0b00000111;
+
+    // out of frames, so hold the last one as soon as the chip gets to it.
+    // it may have gone past already, so hold the last frame, not whatever is showing.
+    if ( ( _endslot != 0xFF ) && ( advanced >= ( ( _endslot - _shownslot ) & 0b00000111 ) ) ) {
+
+        _playing = 0;
+        _draw = NULL;
+
+        _matrix->beginUpdate();
+        _matrix->frameDisplayPointerSet( _endslot );
+        _matrix->displayModeSet( 0b00 );
+        _status = _matrix->commit();
+
+        return 0;
+
+    }
+
+    _shownslot = currentslot;
+    _freeslots += advanced;
+
+    // never more than the ring, less the one showing
+    if ( _freeslots > 7 ) { _freeslots = 7; }
+
+    // top the ring back up
+    while ( _freeslots ) {
+
+        // out of frames, the pixel buffers still hold the last one.  copy it round the ring,
+        // so a late poll() finds the chip showing the last frame, not one from the lap before.
+        if ( !_slotFill( _fillslot ) ) { _status = _matrix->pixelBufferWriteAllToFrame( _fillslot ); }
+
+        if ( _status ) { _playing = 0; return 0; }
+
+        _fillslot = ( _fillslot + 1 ) & 0b00000111;
+        _freeslots--;
+
+    }
+
+    return 1;
+
+}
+
+
+
+
+/// @brief Stop playing, holding whatever frame is on display in picture mode.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixPlayerT< Transport >::stop() {
+
+    _playing = 0;
+    _draw = NULL;
+
+    uint8_t currentslot = _matrix->currentFrameDisplayGet();
+
+    _status = _matrix->lastStatusGet();
+    if ( _status ) { return _status; }
+
+    _matrix->beginUpdate();
+    _matrix->frameDisplayPointerSet( currentslot );
+    _matrix->displayModeSet( 0b00 );
+    _status = _matrix->commit();
+
+    return _status;
+
+}
+
+
+/// @brief Checks if an animation is playing.
+/// @return 1 if playing, 0 if not.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixPlayerT< Transport >::playing() {
+
+    return _playing;
+
+}
+
+
+/// @brief Gets how many animation frames have been drawn so far.
+/// @return The number of frames.
+template< class Transport >
+uint32_t Pimoroni_11x7matrixPlayerT< Transport >::framesDrawnGet() {
+
+    return _nextindex;
+
+}
+
+
+/// @brief Gets how the last bus operation went.
+/// @return PIMORONI_11X7MATRIX_OK, or an error code.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixPlayerT< Transport >::statusGet() {
+
+    return _status;
+
+}
+
+
+
+
+#endif
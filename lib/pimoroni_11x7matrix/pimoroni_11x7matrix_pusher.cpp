@@ -0,0 +1,11 @@
+// include my header
+#include <pimoroni_11x7matrix_pusher.h>
+
+// and the implementation
+#include <pimoroni_11x7matrix_pusher_impl.h>
+
+
+
+
+// build the pusher for the usual Wire bus
+template class Pimoroni_11x7matrixPusherT< Pimoroni_11x7matrixWireTransport >;
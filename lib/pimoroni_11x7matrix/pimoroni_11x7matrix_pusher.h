@@ -0,0 +1,106 @@
+#ifndef PIMORONI_11X7MATRIX_PUSHER_HEADER_GUARD
+#define PIMORONI_11X7MATRIX_PUSHER_HEADER_GUARD
+
+
+// background frame pusher for the 11x7 matrix board by pimoroni
+
+// pull in the matrix driver
+#include <pimoroni_11x7matrix.h>
+
+
+
+
+/// @brief Called when a queued frame has finished going out to the chip.
+/// @param framenumber The number of the frame that was written. 0-7.
+/// @param status PIMORONI_11X7MATRIX_OK, or the error that stopped it.  On error the unsent columns are dirty again.
+typedef void (*Pimoroni_11x7matrixPushCallback)( uint8_t framenumber , uint8_t status );
+
+
+
+
+/// @brief Streams a snapshot of the pixel buffers to a frame in the background.
+/// Use Pimoroni_11x7matrixPusher with the usual Pimoroni_11x7matrix.
+/// queue() takes a copy of everything that needs sending, so the pixel buffers are free to draw the next frame
+/// straight away.  Call poll() from loop(), each call sends at most one transaction, never more than one wire buffer of bus time.
+/// While a frame is going out the blocking pixelBuffer*WriteToFrame() calls refuse that frame with
+/// PIMORONI_11X7MATRIX_ERROR_BUSY, the rest of the snapshot would land on top of what they sent.  Other frames are fine.
+/// Use one pusher per matrix.
+template< class Transport >
+class Pimoroni_11x7matrixPusherT {
+
+
+    private:
+
+    /// @brief The matrix the queued frame belongs to.
+    Pimoroni_11x7matrixT< Transport > *_matrix;
+
+    /// @brief Snapshot of the frame image, registers 0x00-0x7A.
+    uint8_t _image[ PIMORONI_11X7MATRIX_FRAME_LAST_REG + 1 ];
+
+    /// @brief The columns of the snapshot that still need sending.
+    Pimoroni_11x7matrixFrameMask _mask;
+
+    /// @brief The frame number being written. 0-7.
+    uint8_t _framenumber;
+
+    /// @brief The next register to consider sending.
+    uint8_t _address;
+
+    /// @brief 1 while a frame is queued or going out.
+    uint8_t _busy;
+
+    /// @brief How the last frame went.
+    uint8_t _status;
+
+    /// @brief Called when the frame has gone out, or NULL.
+    Pimoroni_11x7matrixPushCallback _callback;
+
+
+
+
+
+    public:
+
+    /// @brief Constructor for the background frame pusher.
+    Pimoroni_11x7matrixPusherT();
+
+
+    /// @brief Snapshot the changed parts of the pixel buffers and queue them for a frame.
+    /// @param matrix The matrix to take the pixel buffers from, and send to.
+    /// @param framenumber The number of the frame to write to. 0-7.
+    /// @param callback Called from poll() when the frame has gone out.  NULL for none.
+    /// @return 1 if the frame was queued, 0 if a frame is already going out.
+    uint8_t queue( Pimoroni_11x7matrixT< Transport > &matrix , uint8_t framenumber , Pimoroni_11x7matrixPushCallback callback = NULL );
+
+
+    /// @brief Send the next transaction of the queued frame, if there is one.
+    /// A bus error stops the frame, and hands what was not sent back to the matrix dirty flags.
+    /// @return 1 if there is still more to send, 0 when idle.
+    uint8_t poll();
+
+
+    /// @brief Checks if a frame is queued or going out.
+    /// @return 1 if busy, 0 if idle.
+    uint8_t busy();
+
+
+    /// @brief Gets how the last frame went.
+    /// @return PIMORONI_11X7MATRIX_OK, or the error that stopped it.
+    uint8_t statusGet();
+
+
+};
+
+
+
+
+// the pusher for the usual Wire bus, built once in pimoroni_11x7matrix_pusher.cpp.
+extern template class Pimoroni_11x7matrixPusherT< Pimoroni_11x7matrixWireTransport >;
+typedef Pimoroni_11x7matrixPusherT< Pimoroni_11x7matrixWireTransport > Pimoroni_11x7matrixPusher;
+
+
+
+
+
+
+#endif
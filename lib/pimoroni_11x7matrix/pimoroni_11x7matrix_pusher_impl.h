@@ -0,0 +1,153 @@
+#ifndef PIMORONI_11X7MATRIX_PUSHER_IMPL_HEADER_GUARD
+#define PIMORONI_11X7MATRIX_PUSHER_IMPL_HEADER_GUARD
+
+
+// implementation of the background frame pusher template.
+// pimoroni_11x7matrix_pusher.cpp builds it for the default wire transport, include this yourself to build it for another transport.
+
+// include my header
+#include <pimoroni_11x7matrix_pusher.h>
+
+
+
+
+/// @brief Constructor for the background frame pusher.
+template< class Transport >
+Pimoroni_11x7matrixPusherT< Transport >::Pimoroni_11x7matrixPusherT() {
+
+    // nothing queued yet
+    _matrix = NULL;
+    _busy = 0;
+    _status = PIMORONI_11X7MATRIX_OK;
+    _callback = NULL;
+
+}
+
+
+
+
+/// @brief Snapshot the changed parts of the pixel buffers and queue them for a frame.
+/// @param matrix The matrix to take the pixel buffers from, and send to.
+/// @param framenumber The number of the frame to write to. 0-7.
+/// @param callback Called from poll() when the frame has gone out.  NULL for none.
+/// @return 1 if the frame was queued, 0 if a frame is already going out.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixPusherT< Transport >::queue( Pimoroni_11x7matrixT< Transport > &matrix , uint8_t framenumber , Pimoroni_11x7matrixPushCallback callback ) {
+
+    // one frame at a time
+    if ( _busy ) { return 0; }
+
+    _matrix = &matrix;
+    _framenumber = framenumber;
+    _callback = callback;
+
+    // blocking writes keep off this frame until we are done with it
+    _matrix->_pushframe = framenumber;
+
+    // find out what needs sending.  from here on the matrix counts it as sent,
+    // so anything drawn after this marks it dirty again for the next frame.
+    _matrix->_frameImageDirtyTake( framenumber , PIMORONI_11X7MATRIX_BUFFER_STATE | PIMORONI_11X7MATRIX_BUFFER_BLINK | PIMORONI_11X7MATRIX_BUFFER_PWM , &_mask );
+
+    // take a copy of the frame image, so drawing can carry on while it goes out.
+    // the pixel buffers are in register order, so it is mostly a handful of straight copies.
+    uint8_t address = 0x00;
+
+    while ( address <= PIMORONI_11X7MATRIX_FRAME_LAST_REG ) {
+
+        uint8_t count;
+        const uint8_t *span = _matrix->_frameImageSpan( address , &count );
+
+        if ( span ) { memcpy( &_image[ address ] , span , count ); }
+        else { for ( uint8_t i = 0 ; i < count ; i++ ) { _image[ address + i ] = _matrix->_frameImageByte( address + i ); } }
+
+        address += count;
+
+    }
+
+    // start from the top
+    _address = 0x00;
+    _status = PIMORONI_11X7MATRIX_OK;
+    _busy = 1;
+
+    // all done, return to caller
+    return 1;
+
+}
+
+
+
+
+/// @brief Send the next transaction of the queued frame, if there is one.
+/// A bus error stops the frame, and hands what was not sent back to the matrix dirty flags.
+/// @return 1 if there is still more to send, 0 when idle.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixPusherT< Transport >::poll() {
+
+    // nothing to do?
+    if ( !_busy ) { return 0; }
+
+    #if defined( PIMORONI_11X7MATRIX_INSTRUMENTATION )
+    typename Pimoroni_11x7matrixT< Transport >::_InstrumentationScope instrumentationscope( _matrix , PIMORONI_11X7MATRIX_API_PUSHER );
+    #endif
+
+    // skip over anything that does not need sending
+    while ( ( _address <= PIMORONI_11X7MATRIX_FRAME_LAST_REG ) && !_matrix->_frameImageWanted( _address , &_mask ) ) { _address++; }
+
+    // selecting the frame is a transaction of its own, so it gets a poll of its own
+    if ( ( _address <= PIMORONI_11X7MATRIX_FRAME_LAST_REG ) && ( _matrix->_currentframe != _framenumber ) ) {
+
+        _status = _matrix->_switchFrame( _framenumber );
+
+    }
+    else {
+
+        // send one run, if there is anything left
+        _status = _matrix->_frameImageRunWrite( _framenumber , &_address , &_mask , _image );
+
+    }
+
+    // more to come?
+    if ( !_status && ( _address <= PIMORONI_11X7MATRIX_FRAME_LAST_REG ) ) { return 1; }
+
+    // if it went wrong we can't tell what made it, so the matrix has to send it all again.
+    if ( _status ) { _matrix->_frameImageDirtyReturn( _framenumber , &_mask ); }
+
+    // that was the lot
+    _busy = 0;
+    _matrix->_pushframe = 0xFF;
+
+    // let the caller know
+    if ( _callback ) { _callback( _framenumber , _status ); }
+
+    return 0;
+
+}
+
+
+
+
+/// @brief Checks if a frame is queued or going out.
+/// @return 1 if busy, 0 if idle.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixPusherT< Transport >::busy() {
+
+    return _busy;
+
+}
+
+
+
+
+/// @brief Gets how the last frame went.
+/// @return PIMORONI_11X7MATRIX_OK, or the error that stopped it.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixPusherT< Transport >::statusGet() {
+
+    return _status;
+
+}
+
+
+
+
+#endif
@@ -0,0 +1,11 @@
+// include my header
+#include <pimoroni_11x7matrix_text.h>
+
+// and the implementation
+#include <pimoroni_11x7matrix_text_impl.h>
+
+
+
+
+// build the text renderer for the usual Wire bus
+template class Pimoroni_11x7matrixTextT< Pimoroni_11x7matrixWireTransport >;
@@ -0,0 +1,127 @@
+#ifndef PIMORONI_11X7MATRIX_TEXT_HEADER_GUARD
+#define PIMORONI_11X7MATRIX_TEXT_HEADER_GUARD
+
+
+// text for the 11x7 matrix board by pimoroni, from the bitmap fonts in flash
+
+// pull in the matrix driver
+#include <pimoroni_11x7matrix.h>
+
+// and the fonts
+#include <pimoroni_11x7matrix_font.h>
+
+
+
+
+/// @brief Draws text into a matrix's pixel buffers, a glyph column at a time.
+/// Use Pimoroni_11x7matrixText with the usual Pimoroni_11x7matrix.
+/// Each glyph column is read from flash and stored with one masked byte write, so a full board of text
+/// is 11 buffer writes and redrawing it every frame only marks the columns that really changed.
+/// Text is drawn over its glyph box, the rows of the font from ypos up, so the old text underneath goes
+/// and everything above and below is left alone.  The blank columns between glyphs are cleared too.
+/// Positions may be off the board, negative ones included, so scrolling is just drawing at a smaller x each frame.
+/// The matrix's orientation is followed, and so is brightness only mode.  Send the result with the matrix's usual write functions.
+template< class Transport >
+class Pimoroni_11x7matrixTextT {
+
+
+    private:
+
+    /// @brief The matrix to draw into.
+    Pimoroni_11x7matrixT< Transport > *_matrix;
+
+    /// @brief The font to draw with.
+    const Pimoroni_11x7matrixFont *_font;
+
+    /// @brief The pwm value for lit pixels, or 0 to leave the pwm alone.
+    uint8_t _pwm;
+
+    /// @brief Finds a glyph in the font, '?' for anything the font does not have.
+    /// @param c The character.
+    /// @param width Set to the width of the glyph in columns.
+    /// @return Where its columns start, in PROGMEM.
+    const uint8_t *_glyphFind( char c , uint8_t &width );
+
+    /// @brief Moves a column mask up or down, dropping whatever goes off the board.
+    /// @param mask The mask, bit 0 at the bottom of the glyph.
+    /// @param ypos How far up to move it, negative for down.
+    /// @return The mask, bit 0 at the bottom of the board.
+    uint8_t _rowShift( uint8_t mask , int8_t ypos );
+
+    /// @brief Store one column of text.
+    /// @param xpos The x position of the column.  Anything off the board is ignored.
+    /// @param cover The rows of the glyph box in this column, bit 0 at the bottom.
+    /// @param pattern Which of those rows are lit.
+    void _columnBlit( int16_t xpos , uint8_t cover , uint8_t pattern );
+
+
+
+    public:
+
+    /// @brief Constructor for the text renderer.
+    /// @param matrix The matrix to draw into.
+    /// @param font The font to draw with.
+    Pimoroni_11x7matrixTextT( Pimoroni_11x7matrixT< Transport > &matrix , const Pimoroni_11x7matrixFont &font = pimoroni_11x7matrixFont5x7 );
+
+
+    /// @brief Set the font to draw with.
+    /// @param font pimoroni_11x7matrixFont5x7, pimoroni_11x7matrixFont3x5, pimoroni_11x7matrixFontVariable, or your own.
+    void fontSet( const Pimoroni_11x7matrixFont &font );
+
+    /// @brief Gets the font being drawn with.
+    /// @return The font.
+    const Pimoroni_11x7matrixFont &fontGet();
+
+    /// @brief Set the pwm value of the pixels text lights.
+    /// @param value The pwm value, or 0 to leave the pwm buffer alone, which is how it starts.
+    void pwmSet( uint8_t value );
+
+    /// @brief Gets the pwm value of the pixels text lights.
+    /// @return The pwm value, or 0 if the pwm buffer is left alone.
+    uint8_t pwmGet();
+
+
+
+
+    /// @brief Draw one character, and the blank columns after it.
+    /// @param xpos The x position of its left edge.  May be off the board.
+    /// @param ypos The y position of the bottom of its glyph box.  May be off the board.
+    /// @param c The character.  Anything the font does not have is drawn as '?'.
+    /// @return The x position for the next character.
+    int16_t charDraw( int16_t xpos , int8_t ypos , char c );
+
+    /// @brief Draw a string, with the blank columns after each character.
+    /// Characters wholly off either side of the board are only measured, not read from flash.
+    /// @param xpos The x position of its left edge.  May be off the board.
+    /// @param ypos The y position of the bottom of its glyph box.  May be off the board.
+    /// @param text The string.
+    /// @return The x position for whatever comes next.
+    int16_t stringDraw( int16_t xpos , int8_t ypos , const char *text );
+
+
+    /// @brief Gets the width of one character, without the blank columns after it.
+    /// @param c The character.
+    /// @return The width in columns.
+    uint8_t charWidthGet( char c );
+
+    /// @brief Gets the width of a string, with the blank columns between characters but not after the last.
+    /// @param text The string.
+    /// @return The width in columns, 0 for an empty string.
+    uint16_t stringWidthGet( const char *text );
+
+
+};
+
+
+
+
+// the text renderer for the usual Wire bus, built once in pimoroni_11x7matrix_text.cpp.
+extern template class Pimoroni_11x7matrixTextT< Pimoroni_11x7matrixWireTransport >;
+typedef Pimoroni_11x7matrixTextT< Pimoroni_11x7matrixWireTransport > Pimoroni_11x7matrixText;
+
+
+
+
+
+
+#endif
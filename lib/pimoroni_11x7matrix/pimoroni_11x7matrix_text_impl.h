@@ -0,0 +1,256 @@
+#ifndef PIMORONI_11X7MATRIX_TEXT_IMPL_HEADER_GUARD
+#define PIMORONI_11X7MATRIX_TEXT_IMPL_HEADER_GUARD
+
+
+// implementation of the text renderer template.
+// pimoroni_11x7matrix_text.cpp builds it for the default wire transport, include this yourself to build it for another transport.
+
+// include my header
+#include <pimoroni_11x7matrix_text.h>
+
+
+
+
+/// @brief Constructor for the text renderer.
+/// @param matrix The matrix to draw into.
+/// @param font The font to draw with.
+template< class Transport >
+Pimoroni_11x7matrixTextT< Transport >::Pimoroni_11x7matrixTextT( Pimoroni_11x7matrixT< Transport > &matrix , const Pimoroni_11x7matrixFont &font ) {
+
+    _matrix = &matrix;
+    _font = &font;
+
+    _pwm = 0;
+
+}
+
+
+
+
+/// @brief Finds a glyph in the font, '?' for anything the font does not have.
+/// @param c The character.
+/// @param width Set to the width of the glyph in columns.
+/// @return Where its columns start, in PROGMEM.
+template< class Transport >
+const uint8_t *Pimoroni_11x7matrixTextT< Transport >::_glyphFind( char c , uint8_t &width ) {
+
+    uint8_t index = (uint8_t)( c );
+
+    // not in the font, so a question mark, or the first glyph if it has none of those either
+    if ( ( index < _font->first ) || ( index > _font->last ) ) {
+
+        index = ( ( '?' < _font->first ) || ( '?' > _font->last ) ) ? _font->first : '?';
+
+    }
+
+    index -= _font->first;
+
+    // fixed width, so it is just a multiply
+    if ( !_font->widths ) {
+
+        width = _font->width;
+        return _font->columns + ( (uint16_t)( index ) * width );
+
+    }
+
+    width = pgm_read_byte( &_font->widths[ index ] );
+    return _font->columns + pgm_read_word( &_font->offsets[ index ] );
+
+}
+
+
+/// @brief Moves a column mask up or down, dropping whatever goes off the board.
+/// @param mask The mask, bit 0 at the bottom of the glyph.
+/// @param ypos How far up to move it, negative for down.
+/// @return The mask, bit 0 at the bottom of the board.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixTextT< Transport >::_rowShift( uint8_t mask , int8_t ypos ) {
+
+    if ( ( ypos >= 7 ) || ( ypos <= -8 ) ) { return 0x00; }
+
+    if ( ypos < 0 ) { return ( mask >> -ypos ) & 0b01111111; }
+
+    return ( mask << ypos ) & 0b01111111;
+
+}
+
+
+/// @brief Store one column of text.
+/// @param xpos The x position of the column.  Anything off the board is ignored.
+/// @param cover The rows of the glyph box in this column, bit 0 at the bottom.
+/// @param pattern Which of those rows are lit.
+template< class Transport >
+void Pimoroni_11x7matrixTextT< Transport >::_columnBlit( int16_t xpos , uint8_t cover , uint8_t pattern ) {
+
+    if ( ( xpos < 0 ) || ( xpos >= 11 ) ) { return; }
+
+    uint8_t chipindex = _matrix->_columnmap[ xpos ];
+
+    cover = _matrix->_columnMaskOrient( cover );
+    pattern = _matrix->_columnMaskOrient( pattern ) & cover;
+
+    // one masked write, through the pwm in brightness only mode
+    _matrix->_stateColumnSet( chipindex , ( _matrix->_stateColumnGet( chipindex ) & ~cover ) | pattern );
+
+    if ( !_pwm ) { return; }
+
+    // the pattern is already the way up the chip has it
+    for ( uint8_t y = 0 ; y < 7 ; y++ ) {
+
+        if ( ( pattern >> y ) & 0b00000001 ) { _matrix->_pwmBufferSet( chipindex , y , _pwm ); }
+
+    }
+
+    // all done, return to caller.
+    return;
+
+}
+
+
+
+
+/// @brief Set the font to draw with.
+/// @param font The font.
+template< class Transport >
+void Pimoroni_11x7matrixTextT< Transport >::fontSet( const Pimoroni_11x7matrixFont &font ) {
+
+    _font = &font;
+
+}
+
+
+/// @brief Gets the font being drawn with.
+/// @return The font.
+template< class Transport >
+const Pimoroni_11x7matrixFont &Pimoroni_11x7matrixTextT< Transport >::fontGet() {
+
+    return *_font;
+
+}
+
+
+/// @brief Set the pwm value of the pixels text lights.
+/// @param value The pwm value, or 0 to leave the pwm buffer alone.
+template< class Transport >
+void Pimoroni_11x7matrixTextT< Transport >::pwmSet( uint8_t value ) {
+
+    _pwm = value;
+
+}
+
+
+/// @brief Gets the pwm value of the pixels text lights.
+/// @return The pwm value, or 0 if the pwm buffer is left alone.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixTextT< Transport >::pwmGet() {
+
+    return _pwm;
+
+}
+
+
+
+
+/// @brief Draw one character, and the blank columns after it.
+/// @param xpos The x position of its left edge.
+/// @param ypos The y position of the bottom of its glyph box.
+/// @param c The character.
+/// @return The x position for the next character.
+template< class Transport >
+int16_t Pimoroni_11x7matrixTextT< Transport >::charDraw( int16_t xpos , int8_t ypos , char c ) {
+
+    uint8_t width;
+    const uint8_t *columns = _glyphFind( c , width );
+
+    int16_t next = xpos + width + _font->spacing;
+
+    // wholly off the side of the board, nothing to read
+    if ( ( next <= 0 ) || ( xpos >= 11 ) ) { return next; }
+
+    // the rows of the glyph box, or wholly off the top or bottom
+    uint8_t cover = _rowShift( ( 0b00000001 << _font->height ) - 1 , ypos );
+    if ( !cover ) { return next; }
+
+    for ( uint8_t column = 0 ; column < width ; column++ ) {
+
+        int16_t x = xpos + column;
+
+        if ( x < 0 ) { continue; }
+        if ( x >= 11 ) { return next; }
+
+        _columnBlit( x , cover , _rowShift( pgm_read_byte( &columns[ column ] ) , ypos ) );
+
+    }
+
+    // and the gap before the next one
+    for ( int16_t x = xpos + width ; x < next ; x++ ) {
+
+        _columnBlit( x , cover , 0x00 );
+
+    }
+
+    return next;
+
+}
+
+
+/// @brief Draw a string, with the blank columns after each character.
+/// @param xpos The x position of its left edge.
+/// @param ypos The y position of the bottom of its glyph box.
+/// @param text The string.
+/// @return The x position for whatever comes next.
+template< class Transport >
+int16_t Pimoroni_11x7matrixTextT< Transport >::stringDraw( int16_t xpos , int8_t ypos , const char *text ) {
+
+    while ( *text ) {
+
+        xpos = charDraw( xpos , ypos , *text );
+        text++;
+
+    }
+
+    return xpos;
+
+}
+
+
+/// @brief Gets the width of one character, without the blank columns after it.
+/// @param c The character.
+/// @return The width in columns.
+template< class Transport >
+uint8_t Pimoroni_11x7matrixTextT< Transport >::charWidthGet( char c ) {
+
+    uint8_t width;
+    _glyphFind( c , width );
+
+    return width;
+
+}
+
+
+/// @brief Gets the width of a string, with the blank columns between characters but not after the last.
+/// @param text The string.
+/// @return The width in columns, 0 for an empty string.
+template< class Transport >
+uint16_t Pimoroni_11x7matrixTextT< Transport >::stringWidthGet( const char *text ) {
+
+    uint16_t width = 0;
+
+    if ( !*text ) { return 0; }
+
+    while ( *text ) {
+
+        width += charWidthGet( *text ) + _font->spacing;
+        text++;
+
+    }
+
+    // no gap after the last one
+    return width - _font->spacing;
+
+}
+
+
+
+
+#endif
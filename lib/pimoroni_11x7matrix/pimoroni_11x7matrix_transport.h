@@ -0,0 +1,161 @@
+#ifndef PIMORONI_11X7MATRIX_TRANSPORT_HEADER_GUARD
+#define PIMORONI_11X7MATRIX_TRANSPORT_HEADER_GUARD
+
+
+// bus transports for the 11x7 matrix board by pimoroni
+//
+// the driver is a template over its transport, so every bus call is a plain inlined call, no virtuals.
+// any class with these members will do:
+//
+//   void begin();                                             start the bus
+//   void setClock( uint32_t busclock );                       bus clock in hz
+//   void timeoutSet( uint32_t microseconds );                 time out stuck transactions, if the bus can
+//   void beginTransmission( uint8_t address );                start a write
+//   void write( uint8_t data );                               queue a byte to write
+//   void write( const uint8_t *data , uint8_t count );        queue several bytes to write
+//   uint8_t endTransmission();                                send it, 0 on success, wire library codes on failure
+//   uint8_t requestFrom( uint8_t address , uint8_t count );   read bytes, returns how many came back
+//   int available();                                          bytes waiting to be read
+//   int read();                                               next byte read
+//   uint8_t recover();                                        free a stuck bus and start it again, 0 on success
+
+// pull in the arduino headers
+#include <Arduino.h>
+
+// pull in the wire library
+#include <Wire.h>
+
+
+
+
+/// @brief Transport over a TwoWire bus, Wire unless told otherwise.
+class Pimoroni_11x7matrixWireTransport {
+
+
+    private:
+
+    /// @brief The bus to talk over.
+    TwoWire *_bus;
+
+
+
+    public:
+
+    /// @brief Constructor for the wire transport.
+    /// @param bus The bus to talk over.
+    Pimoroni_11x7matrixWireTransport( TwoWire &bus = Wire ) : _bus( &bus ) {}
+
+
+    /// @brief Start the bus.
+    void begin() { _bus->begin(); }
+
+    /// @brief Set the bus clock.
+    /// @param busclock The bus clock in hz.
+    void setClock( uint32_t busclock ) { _bus->setClock( busclock ); }
+
+    /// @brief Stop the wire library hanging on a wedged bus, where the core supports it.
+    /// @param microseconds The timeout in microseconds.
+    void timeoutSet( uint32_t microseconds ) {
+
+        #if defined( WIRE_HAS_TIMEOUT )
+        _bus->setWireTimeout( microseconds , true );
+        #else
+        (void)( microseconds );
+        #endif
+
+    }
+
+    /// @brief Start a write transaction.
+    /// @param address The i2c address of the chip.
+    void beginTransmission( uint8_t address ) { _bus->beginTransmission( address ); }
+
+    /// @brief Queue a byte to write.
+    /// @param data The byte.
+    void write( uint8_t data ) { _bus->write( data ); }
+
+    /// @brief Queue several bytes to write.
+    /// @param data The bytes.
+    /// @param count How many bytes.
+    void write( const uint8_t *data , uint8_t count ) { _bus->write( data , count ); }
+
+    /// @brief Send the queued bytes.
+    /// @return 0 on success, otherwise the wire library error code.
+    uint8_t endTransmission() { return _bus->endTransmission(); }
+
+    /// @brief Read bytes from the chip.
+    /// @param address The i2c address of the chip.
+    /// @param count How many bytes to read.
+    /// @return How many bytes came back.
+    uint8_t requestFrom( uint8_t address , uint8_t count ) { return _bus->requestFrom( address , count ); }
+
+    /// @brief How many bytes are waiting to be read.
+    int available() { return _bus->available(); }
+
+    /// @brief Get the next byte read.
+    int read() { return _bus->read(); }
+
+
+    /// @brief Try to free a stuck bus, then start the bus again.
+    /// If a chip was reset part way through sending a byte it can hold SDA low forever.
+    /// Clocking SCL until it lets go, then sending a stop, gets everyone back to idle.
+    /// Only Wire's own pins are known, so other buses are just restarted.
+    /// @return 0 if the bus is free, 1 if it is still held low.
+    uint8_t recover() {
+
+        uint8_t stuck = 0;
+
+        // we can only wiggle the pins if the core tells us which they are
+        #if defined( PIN_WIRE_SDA ) && defined( PIN_WIRE_SCL )
+        if ( _bus == &Wire ) {
+
+            // let go of the pins
+            #if defined( WIRE_HAS_END )
+            _bus->end();
+            #endif
+
+            pinMode( PIN_WIRE_SDA , INPUT_PULLUP );
+            pinMode( PIN_WIRE_SCL , INPUT_PULLUP );
+            delayMicroseconds( 5 );
+
+            // clock out up to 9 bits, until whoever is holding SDA lets go
+            for ( uint8_t i = 0 ; ( i < 9 ) && ( digitalRead( PIN_WIRE_SDA ) == LOW ) ; i++ ) {
+
+                // pull SCL low, never drive it high
+                digitalWrite( PIN_WIRE_SCL , LOW );
+                pinMode( PIN_WIRE_SCL , OUTPUT );
+                delayMicroseconds( 5 );
+
+                // and let it float back up
+                pinMode( PIN_WIRE_SCL , INPUT_PULLUP );
+                delayMicroseconds( 5 );
+
+            }
+
+            // send a stop, SDA going high while SCL is high
+            digitalWrite( PIN_WIRE_SDA , LOW );
+            pinMode( PIN_WIRE_SDA , OUTPUT );
+            delayMicroseconds( 5 );
+            pinMode( PIN_WIRE_SDA , INPUT_PULLUP );
+            delayMicroseconds( 5 );
+
+            // still held low?
+            if ( ( digitalRead( PIN_WIRE_SDA ) == LOW ) || ( digitalRead( PIN_WIRE_SCL ) == LOW ) ) { stuck = 1; }
+
+        }
+        #endif
+
+        // start the wire library again
+        _bus->begin();
+
+        return stuck;
+
+    }
+
+
+};
+
+
+
+
+
+#endif
@@ -25,6 +25,8 @@ LiquidCrystal lcd(8, 9, 4, 5, 6, 7);
 
 #include <pimoroni_11x7matrix.h>
 
+#include <pimoroni_11x7matrix_benchmark.h>
+
 
 
 
@@ -37,14 +39,15 @@ LiquidCrystal lcd(8, 9, 4, 5, 6, 7);
 // define the menu options
 int8_t menucurrentchoice = 0;
 
-uint8_t menumaxchoices = 6;
+uint8_t menumaxchoices = 7;
 
-String menutext[6] = { "I2C Scan" ,
+String menutext[7] = { "I2C Scan" ,
                        "Test 1" ,
                        "Test 2" ,
                        "Test 3" ,
                        "Test 4" ,
-                       "Test 5"
+                       "Test 5" ,
+                       "Benchmark"
                        };
 
 
@@ -134,11 +137,14 @@ void menucommand_02() {
   // now turn the chip back on...
   myledmatrix.softwareShutdownSet( 1 );
 
+  // draw into frame 1 while frame 0 is showing, so nothing half drawn is seen.
+  myledmatrix.doubleBufferBegin( 0 , 1 );
+
   // turn on the new pixel
   myledmatrix.pixelSet( 0 , 0 , 1 );
 
-  // update the device
-  myledmatrix.pixelBufferStateWriteToFrame( 0 );
+  // update the device, and flip to it
+  myledmatrix.present();
   
   delay( 1000 );
 
@@ -303,6 +309,8 @@ void menucommand_04() {
   myledmatrix.pixelBufferWriteAllToFrame( 7 );
 
 
+  // collect the register changes below and send them in one go.
+  myledmatrix.beginUpdate();
 
   myledmatrix.blinkEnableSet( 1 );
 
@@ -347,6 +355,9 @@ void menucommand_04() {
   // now turn the chip on
   myledmatrix.softwareShutdownSet( 1 );
 
+  // send all of the register changes to the chip.
+  myledmatrix.commit();
+
   // now wait.
   //while(1);
 
@@ -358,6 +369,52 @@ void menucommand_05() {};
 
 
 
+// benchmark the uploads and configuration at each bus clock, results go out over serial.
+void menucommand_06() {
+
+  // move cursor to home
+  lcd.clear();
+  lcd.setCursor( 0 , 0 );
+  lcd.print( "Benchmarking" );
+
+  Pimoroni_11x7matrix myledmatrix;
+
+  Pimoroni_11x7matrixBenchmark mybenchmark( myledmatrix );
+
+  const uint32_t busclocks[ 3 ] = { 100000 , 400000 , 1000000 };
+
+  mybenchmark.printHeader();
+
+  for ( uint8_t i = 0 ; i < 3 ; i++ ) {
+
+    // show which clock we are on
+    lcd.setCursor( 0 , 1 );
+    lcd.print( busclocks[ i ] );
+    lcd.print( "hz   " );
+
+    uint8_t status = mybenchmark.run( IS31FL3731_I2C_ADDRESS , busclocks[ i ] , 20 );
+
+    mybenchmark.print();
+
+    if ( status ) {
+      lcd.setCursor( 0 , 1 );
+      lcd.print( "Error " );
+      lcd.print( status );
+      return;
+    }
+
+  }
+
+  lcd.setCursor( 0 , 1 );
+  lcd.print( "Done            " );
+
+  // leave it on the screen for a bit
+  delay( 2000 );
+
+}
+
+
+
 
 
 
@@ -411,6 +468,10 @@ void domenuaction() {
   case 5:
     menucommand_05();
     break;
+
+  case 6:
+    menucommand_06();
+    break;
   
   default:
     break;
@@ -0,0 +1,99 @@
+// benchmarks for the 11x7 matrix driver against the simulated chip and bus.
+// run with: pio test -e native -f test_native_benchmark -v
+//
+// micros() runs off the simulated bus, so the numbers are the same every run.
+// the budgets below are what the driver costs today plus 10%, a change that makes an upload dearer fails here.
+
+#include <unity.h>
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#include <IS31FL3731_sim.h>
+#include <pimoroni_11x7matrix.h>
+#include <pimoroni_11x7matrix_benchmark.h>
+
+
+
+
+// the chip on the simulated bus
+IS31FL3731Sim chip( 0x75 );
+
+// the bus clocks to run at
+const uint32_t busclocks[ 3 ] = { 100000 , 400000 , 1000000 };
+
+// the most each call may cost at each bus clock, in microseconds
+const uint32_t budgets[ 3 ][ PIMORONI_11X7MATRIX_BENCH_COUNT ] = {
+
+    // begin, write_all, write_state, write_pwm, write_pixel, autoplay
+    { 17700 , 11700 , 1310 , 9100 , 320 , 98000 } ,
+    {  4430 ,  2930 ,  330 , 2270 ,  80 , 24500 } ,
+    {  1780 ,  1170 ,  135 ,  910 ,  33 ,  9800 }
+
+};
+
+
+
+
+void setUp() {
+
+    chip.reset();
+
+}
+
+
+void tearDown() {}
+
+
+
+
+// run every test at one bus clock, print it, and hold it to the budget.
+void benchmarkRun( uint8_t clockindex ) {
+
+    Pimoroni_11x7matrix matrix;
+    Pimoroni_11x7matrixBenchmark benchmark( matrix );
+
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , benchmark.run( 0x75 , busclocks[ clockindex ] , 20 ) );
+
+    benchmark.print();
+
+    for ( uint8_t test = 0 ; test < PIMORONI_11X7MATRIX_BENCH_COUNT ; test++ ) {
+
+        Pimoroni_11x7matrixBenchmarkResult result;
+        benchmark.resultGet( test , &result );
+
+        TEST_ASSERT_EQUAL_UINT32( busclocks[ clockindex ] , result.busclock );
+        TEST_ASSERT_EQUAL_UINT32( 20 , result.iterations );
+        TEST_ASSERT_LESS_THAN_UINT32( budgets[ clockindex ][ test ] , result.microseconds / result.iterations );
+
+    }
+
+}
+
+
+void test_benchmark_100khz() { benchmarkRun( 0 ); }
+void test_benchmark_400khz() { benchmarkRun( 1 ); }
+void test_benchmark_1mhz() { benchmarkRun( 2 ); }
+
+
+
+
+int main( int argc , char **argv ) {
+
+    (void)( argc );
+    (void)( argv );
+
+    Wire.attach( chip );
+
+    UNITY_BEGIN();
+
+    Pimoroni_11x7matrix matrix;
+    Pimoroni_11x7matrixBenchmark( matrix ).printHeader();
+
+    RUN_TEST( test_benchmark_100khz );
+    RUN_TEST( test_benchmark_400khz );
+    RUN_TEST( test_benchmark_1mhz );
+
+    return UNITY_END();
+
+}
@@ -0,0 +1,155 @@
+// the 11x7 matrix driver with the pwm buffer packed to 4 bits a pixel.
+// run with: pio test -e native_packed
+
+#include <unity.h>
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#include <IS31FL3731_sim.h>
+#include <pimoroni_11x7matrix.h>
+
+
+// this suite only means anything with the packed buffer
+#if !defined( PIMORONI_11X7MATRIX_PACKED_PWM )
+#error "build with -D PIMORONI_11X7MATRIX_PACKED_PWM, pio test -e native_packed does."
+#endif
+
+
+
+
+// the chip on the simulated bus
+IS31FL3731Sim chip( 0x75 );
+
+
+
+
+void setUp() {
+
+    chip.reset();
+
+    Wire.setClock( 100000 );
+    Wire.statsReset();
+
+}
+
+
+void tearDown() {}
+
+
+
+
+// values snap to the nearest level, and the levels themselves come back exactly.
+void test_packed_quantize() {
+
+    Pimoroni_11x7matrix matrix;
+
+    for ( uint8_t level = 0 ; level < 16 ; level++ ) {
+
+        uint8_t value = pgm_read_byte( &pimoroni_11x7matrixPwmLevels[ level ] );
+
+        matrix.pixelpwmSet( 3 , 4 , value );
+        TEST_ASSERT_EQUAL_UINT8( value , matrix.pixelpwmGet( 3 , 4 ) );
+
+    }
+
+    matrix.pixelpwmSet( 3 , 4 , 0x80 );
+    TEST_ASSERT_EQUAL_UINT8( 96 , matrix.pixelpwmGet( 3 , 4 ) );
+
+    matrix.pixelpwmSet( 3 , 4 , 0x81 );
+    TEST_ASSERT_EQUAL_UINT8( 160 , matrix.pixelpwmGet( 3 , 4 ) );
+
+    matrix.pixelpwmSet( 3 , 4 , 5 );
+    TEST_ASSERT_EQUAL_UINT8( 4 , matrix.pixelpwmGet( 3 , 4 ) );
+
+    // neighbours sharing a byte are left alone
+    matrix.pixelpwmSet( 3 , 3 , 255 );
+    matrix.pixelpwmSet( 3 , 5 , 0 );
+    TEST_ASSERT_EQUAL_UINT8( 255 , matrix.pixelpwmGet( 3 , 3 ) );
+    TEST_ASSERT_EQUAL_UINT8( 4 , matrix.pixelpwmGet( 3 , 4 ) );
+    TEST_ASSERT_EQUAL_UINT8( 0 , matrix.pixelpwmGet( 3 , 5 ) );
+
+}
+
+
+// the chip is sent the full 8 bit level, in the interleaved registers, with the 8th of each column clear.
+void test_packed_upload() {
+
+    Pimoroni_11x7matrix matrix;
+    matrix.begin( 0x75 );
+
+    const uint8_t chipindex[ 11 ] = { 0 , 2 , 4 , 6 , 8 , 10 , 1 , 3 , 5 , 7 , 9 };
+
+    for ( uint8_t x = 0 ; x < 11 ; x++ ) {
+
+        for ( uint8_t y = 0 ; y < 7 ; y++ ) {
+
+            matrix.pixelpwmSet( x , y , pgm_read_byte( &pimoroni_11x7matrixPwmLevels[ ( x + y ) & 0b00001111 ] ) );
+
+        }
+
+    }
+
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.pixelBufferWriteAllToFrame( 0 ) );
+
+    for ( uint8_t x = 0 ; x < 11 ; x++ ) {
+
+        for ( uint8_t y = 0 ; y < 7 ; y++ ) {
+
+            TEST_ASSERT_EQUAL_HEX8( pgm_read_byte( &pimoroni_11x7matrixPwmLevels[ ( x + y ) & 0b00001111 ] ) , chip.frameRegisterGet( 0 , 0x24 + chipindex[ x ] * 8 + y ) );
+
+        }
+
+        TEST_ASSERT_EQUAL_HEX8( 0x00 , chip.frameRegisterGet( 0 , 0x24 + chipindex[ x ] * 8 + 7 ) );
+
+    }
+
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.pixelBufferVerifyFrame( 0 ) );
+
+    // a single change sends a single column
+    Wire.statsReset();
+    matrix.pixelpwmSet( 5 , 6 , 255 );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.pixelBufferWriteAllToFrame( 0 ) );
+    TEST_ASSERT_EQUAL_HEX8( 255 , chip.frameRegisterGet( 0 , 0x24 + chipindex[ 5 ] * 8 + 6 ) );
+    TEST_ASSERT_LESS_THAN_UINT32( 12 , Wire.statsGet().byteswritten );
+
+}
+
+
+// a frame holding values between levels reads back rounded, and is sent again rather than trusted.
+void test_packed_read_back() {
+
+    Pimoroni_11x7matrix matrix;
+    matrix.begin( 0x75 );
+
+    chip.frameRegisterSet( 0 , 0x24 + 2 , 0x81 );
+
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.pixelBufferReadFromFrame( 0 ) );
+    TEST_ASSERT_EQUAL_UINT8( 160 , matrix.pixelpwmGet( 0 , 2 ) );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_ERROR_VERIFY , matrix.pixelBufferVerifyFrame( 0 ) );
+
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.pixelBufferWriteAllToFrame( 0 ) );
+    TEST_ASSERT_EQUAL_UINT8( 160 , chip.frameRegisterGet( 0 , 0x24 + 2 ) );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.pixelBufferVerifyFrame( 0 ) );
+
+}
+
+
+
+
+int main( int argc , char **argv ) {
+
+    (void)( argc );
+    (void)( argv );
+
+    Wire.attach( chip );
+
+    UNITY_BEGIN();
+
+    RUN_TEST( test_packed_quantize );
+    RUN_TEST( test_packed_upload );
+    RUN_TEST( test_packed_read_back );
+
+    return UNITY_END();
+
+}
@@ -0,0 +1,1442 @@
+// the 11x7 matrix driver against the simulated chip and bus.
+// run with: pio test -e native
+
+#include <unity.h>
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#include <IS31FL3731_sim.h>
+#include <IS31FL3731.h>
+#include <pimoroni_11x7matrix.h>
+#include <pimoroni_11x7matrix_impl.h>
+#include <pimoroni_11x7matrix_pusher.h>
+#include <pimoroni_11x7matrix_canvas.h>
+#include <pimoroni_11x7matrix_player.h>
+#include <pimoroni_11x7matrix_framepool.h>
+#include <pimoroni_11x7matrix_draw.h>
+#include <pimoroni_11x7matrix_text.h>
+
+
+
+
+// the chip on the simulated bus
+IS31FL3731Sim chip( 0x75 );
+
+// a second board, for the canvas
+IS31FL3731Sim chipleft( 0x74 );
+
+
+
+
+void setUp() {
+
+    chip.reset();
+    chip.maxClockSet( IS31FL3731_SIM_DEFAULT_MAX_CLOCK );
+    chipleft.reset();
+
+    Wire.setClock( 100000 );
+    Wire.statsReset();
+
+}
+
+
+void tearDown() {}
+
+
+
+
+// 0xFD selects the page, everything else auto increments from the register address.
+void test_sim_page_select_and_auto_increment() {
+
+    Wire.beginTransmission( 0x75 );
+    Wire.write( 0xFD );
+    Wire.write( 0x03 );
+    TEST_ASSERT_EQUAL_UINT8( 0 , Wire.endTransmission() );
+    TEST_ASSERT_EQUAL_UINT8( 0x03 , chip.pageGet() );
+
+    Wire.beginTransmission( 0x75 );
+    Wire.write( 0x24 );
+    Wire.write( 0x11 );
+    Wire.write( 0x22 );
+    Wire.write( 0x33 );
+    TEST_ASSERT_EQUAL_UINT8( 0 , Wire.endTransmission() );
+
+    TEST_ASSERT_EQUAL_UINT8( 0x11 , chip.frameRegisterGet( 3 , 0x24 ) );
+    TEST_ASSERT_EQUAL_UINT8( 0x22 , chip.frameRegisterGet( 3 , 0x25 ) );
+    TEST_ASSERT_EQUAL_UINT8( 0x33 , chip.frameRegisterGet( 3 , 0x26 ) );
+    TEST_ASSERT_EQUAL_UINT8( 0x00 , chip.frameRegisterGet( 0 , 0x24 ) );
+
+    // the address pointer carries on across reads
+    Wire.beginTransmission( 0x75 );
+    Wire.write( 0x24 );
+    TEST_ASSERT_EQUAL_UINT8( 0 , Wire.endTransmission() );
+
+    TEST_ASSERT_EQUAL_UINT8( 2 , Wire.requestFrom( 0x75 , 2 ) );
+    TEST_ASSERT_EQUAL_INT( 0x11 , Wire.read() );
+    TEST_ASSERT_EQUAL_INT( 0x22 , Wire.read() );
+    TEST_ASSERT_EQUAL_UINT8( 1 , Wire.requestFrom( 0x75 , 1 ) );
+    TEST_ASSERT_EQUAL_INT( 0x33 , Wire.read() );
+
+}
+
+
+// the frame state register ignores writes, and its interrupt clears when read.
+void test_sim_read_only_and_clear_on_read() {
+
+    Wire.beginTransmission( 0x75 );
+    Wire.write( 0xFD );
+    Wire.write( 0x0B );
+    Wire.endTransmission();
+
+    // auto frame play, 1 loop of 2 frames, shortest frame delay
+    Wire.beginTransmission( 0x75 );
+    Wire.write( 0x00 );
+    Wire.write( 0b00001000 );
+    Wire.write( 0x00 );
+    Wire.write( 0b00010010 );
+    Wire.write( 0x01 );
+    Wire.write( 0x00 );
+    Wire.write( 0x00 );
+    Wire.write( 0x00 );
+    Wire.write( 0xFF );
+    Wire.endTransmission();
+
+    TEST_ASSERT_EQUAL_UINT8( 0x00 , chip.controlRegisterGet( 0x07 ) );
+
+    // long enough for both frames to play
+    delay( 30 );
+
+    Wire.beginTransmission( 0x75 );
+    Wire.write( 0x07 );
+    Wire.endTransmission();
+    Wire.requestFrom( 0x75 , 1 );
+    TEST_ASSERT_EQUAL_INT( 0b00010001 , Wire.read() );
+
+    Wire.beginTransmission( 0x75 );
+    Wire.write( 0x07 );
+    Wire.endTransmission();
+    Wire.requestFrom( 0x75 , 1 );
+    TEST_ASSERT_EQUAL_INT( 0b00000001 , Wire.read() );
+
+}
+
+
+// each transaction costs start, stop and 9 bits per byte at the bus clock.
+void test_sim_timing_model() {
+
+    Wire.beginTransmission( 0x75 );
+    Wire.write( 0x00 );
+    Wire.write( 0x00 );
+    Wire.endTransmission();
+
+    // 1 + 1 + 3 bytes of 9 bits, at 10us a bit
+    TEST_ASSERT_EQUAL_UINT32( 290000 , (uint32_t)( Wire.lastNanosecondsGet() ) );
+
+    TwoWireTiming timing = Wire.timingGet();
+    timing.overheadns = 5000;
+    Wire.timingSet( timing );
+    Wire.setClock( 400000 );
+
+    uint64_t before = nativeClockNanosecondsGet();
+
+    Wire.beginTransmission( 0x75 );
+    Wire.write( 0x00 );
+    Wire.write( 0x00 );
+    Wire.endTransmission();
+
+    TEST_ASSERT_EQUAL_UINT32( 72500 + 5000 , (uint32_t)( Wire.lastNanosecondsGet() ) );
+    TEST_ASSERT_EQUAL_UINT32( 72500 + 5000 , (uint32_t)( nativeClockNanosecondsGet() - before ) );
+
+    timing.overheadns = 0;
+    Wire.timingSet( timing );
+
+    TwoWireStats stats = Wire.statsGet();
+    TEST_ASSERT_EQUAL_UINT32( 2 , stats.transactions );
+    TEST_ASSERT_EQUAL_UINT32( 4 , stats.byteswritten );
+
+}
+
+
+
+
+// bursts longer than the wire buffer are split at the right places, both ways.
+void test_is31fl3731_burst() {
+
+    IS31FL3731 driver;
+    driver.i2caddressset( 0x75 );
+
+    uint8_t data[ 100 ];
+    for ( uint8_t i = 0 ; i < 100 ; i++ ) { data[ i ] = i + 1; }
+
+    // page select, then 31 + 31 + 31 + 7 after the register address
+    TEST_ASSERT_EQUAL_UINT8( IS31FL3731_OK , driver.writeBurst( 0 , 0x24 , data , 100 ) );
+    TEST_ASSERT_EQUAL_UINT32( 5 , Wire.statsGet().transactions );
+    TEST_ASSERT_EQUAL_UINT32( 2 + 4 + 100 , Wire.statsGet().byteswritten );
+    TEST_ASSERT_EQUAL_UINT32( 0 , Wire.statsGet().nacks );
+
+    for ( uint8_t i = 0 ; i < 100 ; i++ ) { TEST_ASSERT_EQUAL_HEX8( i + 1 , chip.frameRegisterGet( 0 , 0x24 + i ) ); }
+
+    // each chunk carries on from where the last one stopped
+    TEST_ASSERT_EQUAL_HEX8( 31 , chip.frameRegisterGet( 0 , 0x24 + 30 ) );
+    TEST_ASSERT_EQUAL_HEX8( 32 , chip.frameRegisterGet( 0 , 0x24 + 31 ) );
+    TEST_ASSERT_EQUAL_HEX8( 0x00 , chip.frameRegisterGet( 0 , 0x24 + 100 ) );
+
+    // one address write, then 32 + 32 + 32 + 4, and the page is still selected
+    uint8_t back[ 100 ];
+    Wire.statsReset();
+    TEST_ASSERT_EQUAL_UINT8( IS31FL3731_OK , driver.readBurst( 0 , 0x24 , back , 100 ) );
+    TEST_ASSERT_EQUAL_UINT32( 5 , Wire.statsGet().transactions );
+    TEST_ASSERT_EQUAL_UINT32( 1 , Wire.statsGet().byteswritten );
+    TEST_ASSERT_EQUAL_UINT32( 100 , Wire.statsGet().bytesread );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( data , back , 100 );
+
+}
+
+
+// the page is only selected when it changes, and forgotten when a transfer fails.
+void test_is31fl3731_page_cache() {
+
+    IS31FL3731 driver;
+    driver.i2caddressset( 0x75 );
+
+    chip.countReset();
+
+    driver.write( 1 , 0x00 , 0x01 );
+    driver.write( 1 , 0x01 , 0x02 );
+    driver.write( 1 , 0x02 , 0x03 );
+    TEST_ASSERT_EQUAL_UINT32( 1 , chip.pageSelectCountGet() );
+    TEST_ASSERT_EQUAL_UINT32( 3 , chip.registerWriteCountGet() );
+
+    TEST_ASSERT_EQUAL_HEX8( 0x02 , driver.read( 1 , 0x01 ) );
+    TEST_ASSERT_EQUAL_UINT32( 1 , chip.pageSelectCountGet() );
+
+    driver.write( IS31FL3731_PAGE_CONTROL , 0x01 , 0x01 );
+    TEST_ASSERT_EQUAL_UINT32( 2 , chip.pageSelectCountGet() );
+
+    // a failed write, the same page is selected again afterwards
+    chip.maxClockSet( 50000 );
+    TEST_ASSERT_EQUAL_UINT8( IS31FL3731_ERROR_ADDRESS_NACK , driver.write( IS31FL3731_PAGE_CONTROL , 0x01 , 0x02 ) );
+    TEST_ASSERT_EQUAL_UINT8( IS31FL3731_ERROR_ADDRESS_NACK , driver.laststatusget() );
+    chip.maxClockSet( IS31FL3731_SIM_DEFAULT_MAX_CLOCK );
+
+    chip.countReset();
+    TEST_ASSERT_EQUAL_UINT8( IS31FL3731_OK , driver.write( IS31FL3731_PAGE_CONTROL , 0x01 , 0x02 ) );
+    TEST_ASSERT_EQUAL_UINT32( 1 , chip.pageSelectCountGet() );
+    TEST_ASSERT_EQUAL_HEX8( 0x02 , chip.controlRegisterGet( 0x01 ) );
+
+    // and the same for a failed read
+    chip.maxClockSet( 50000 );
+    uint8_t back[ 2 ];
+    TEST_ASSERT_EQUAL_UINT8( IS31FL3731_ERROR_ADDRESS_NACK , driver.readBurst( IS31FL3731_PAGE_CONTROL , 0x00 , back , 2 ) );
+    chip.maxClockSet( IS31FL3731_SIM_DEFAULT_MAX_CLOCK );
+
+    chip.countReset();
+    TEST_ASSERT_EQUAL_UINT8( IS31FL3731_OK , driver.readBurst( IS31FL3731_PAGE_CONTROL , 0x00 , back , 2 ) );
+    TEST_ASSERT_EQUAL_UINT32( 1 , chip.pageSelectCountGet() );
+    TEST_ASSERT_EQUAL_HEX8( 0x02 , back[ 1 ] );
+
+}
+
+
+
+// the register setters hand back how the write went, modeset() writes nothing if it couldn't read first.
+void test_is31fl3731_setters_status() {
+
+    IS31FL3731 driver;
+    driver.i2caddressset( 0x75 );
+
+    TEST_ASSERT_EQUAL_UINT8( IS31FL3731_OK , driver.modeset( 0b01 ) );
+    TEST_ASSERT_EQUAL_HEX8( 0b00001000 , chip.controlRegisterGet( 0x00 ) );
+    TEST_ASSERT_EQUAL_UINT8( IS31FL3731_OK , driver.frameset( 3 ) );
+    TEST_ASSERT_EQUAL_HEX8( 0x03 , chip.controlRegisterGet( 0x01 ) );
+    TEST_ASSERT_EQUAL_UINT8( IS31FL3731_OK , driver.shutdownset( 1 ) );
+    TEST_ASSERT_EQUAL_HEX8( 0x01 , chip.controlRegisterGet( 0x0A ) );
+
+    chip.maxClockSet( 50000 );
+    chip.countReset();
+    TEST_ASSERT_EQUAL_UINT8( IS31FL3731_ERROR_ADDRESS_NACK , driver.modeset( 0b00 ) );
+    TEST_ASSERT_EQUAL_UINT8( IS31FL3731_ERROR_ADDRESS_NACK , driver.frameset( 5 ) );
+    TEST_ASSERT_EQUAL_UINT8( IS31FL3731_ERROR_ADDRESS_NACK , driver.shutdownset( 0 ) );
+    chip.maxClockSet( IS31FL3731_SIM_DEFAULT_MAX_CLOCK );
+
+    TEST_ASSERT_EQUAL_UINT32( 0 , chip.registerWriteCountGet() );
+    TEST_ASSERT_EQUAL_HEX8( 0b00001000 , chip.controlRegisterGet( 0x00 ) );
+
+}
+
+
+
+// begin() lands on the fastest clock the chip keeps up with, and leaves it cleared and running.
+void test_matrix_begin() {
+
+    chip.maxClockSet( 400000 );
+    chip.frameRegisterSet( 0 , 0x24 , 0x55 );
+
+    Pimoroni_11x7matrix matrix;
+
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.begin( 0x75 , 1000000 ) );
+    TEST_ASSERT_EQUAL_UINT32( 400000 , matrix.busClockGet() );
+
+    TEST_ASSERT_EQUAL_UINT8( 0x00 , chip.frameRegisterGet( 0 , 0x24 ) );
+    TEST_ASSERT_EQUAL_UINT8( 0x01 , chip.controlRegisterGet( 0x0A ) );
+
+}
+
+
+// resume() picks up the chip as it is, without eating the frame interrupt.
+void test_matrix_resume_keeps_interrupt() {
+
+    IS31FL3731 other;
+    other.i2caddressset( 0x75 );
+
+    // auto frame play, 1 loop of 2 frames, shortest frame delay
+    other.write( IS31FL3731_PAGE_CONTROL , 0x02 , 0b00010010 );
+    other.write( IS31FL3731_PAGE_CONTROL , 0x03 , 0x01 );
+    other.write( IS31FL3731_PAGE_CONTROL , 0x0A , 0x01 );
+    other.write( IS31FL3731_PAGE_CONTROL , 0x00 , 0b00001000 );
+
+    // long enough for both frames to play
+    delay( 30 );
+
+    Pimoroni_11x7matrix matrix;
+
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.resume( 0x75 ) );
+    TEST_ASSERT_EQUAL_UINT8( 0x10 , chip.controlRegisterGet( 0x07 ) & 0x10 );
+    TEST_ASSERT_EQUAL_UINT8( 1 , matrix.frameDisplayInterruptGet() );
+
+}
+
+
+// pixels land in the registers the chip interleaves them into.
+void test_matrix_pixel_upload() {
+
+    Pimoroni_11x7matrix matrix;
+    matrix.begin( 0x75 );
+
+    matrix.pixelSet( 6 , 2 , 1 );
+    matrix.pixelpwmSet( 6 , 2 , 0x80 );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.pixelBufferWriteAllToFrame( 0 ) );
+
+    // x 6 is the second column the chip sees
+    TEST_ASSERT_EQUAL_UINT8( 0b00000100 , chip.frameRegisterGet( 0 , 0x01 ) );
+    TEST_ASSERT_EQUAL_UINT8( 0x80 , chip.frameRegisterGet( 0 , 0x24 + 8 + 2 ) );
+
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.pixelBufferVerifyFrame( 0 ) );
+
+}
+
+
+// every column lands in its interleaved register, and reads back to the same x.
+void test_matrix_column_order() {
+
+    Pimoroni_11x7matrix matrix;
+    matrix.begin( 0x75 );
+
+    const uint8_t chipindex[ 11 ] = { 0 , 2 , 4 , 6 , 8 , 10 , 1 , 3 , 5 , 7 , 9 };
+
+    for ( uint8_t x = 0 ; x < 11 ; x++ ) {
+
+        matrix.pixelSet( x , x % 7 , 1 );
+        matrix.pixelBlinkSet( x , ( x + 1 ) % 7 , 1 );
+        matrix.pixelpwmSet( x , x % 7 , 0x10 + x );
+
+    }
+
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.pixelBufferWriteAllToFrame( 0 ) );
+
+    for ( uint8_t x = 0 ; x < 11 ; x++ ) {
+
+        TEST_ASSERT_EQUAL_HEX8( 0b00000001 << ( x % 7 ) , chip.frameRegisterGet( 0 , 0x00 + chipindex[ x ] ) );
+        TEST_ASSERT_EQUAL_HEX8( 0b00000001 << ( ( x + 1 ) % 7 ) , chip.frameRegisterGet( 0 , 0x12 + chipindex[ x ] ) );
+        TEST_ASSERT_EQUAL_HEX8( 0x10 + x , chip.frameRegisterGet( 0 , 0x24 + chipindex[ x ] * 8 + ( x % 7 ) ) );
+
+        // the unconnected 8th register stays clear
+        TEST_ASSERT_EQUAL_HEX8( 0x00 , chip.frameRegisterGet( 0 , 0x24 + chipindex[ x ] * 8 + 7 ) );
+
+    }
+
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.pixelBufferVerifyFrame( 0 ) );
+
+    // and reading it back into a fresh driver puts every pixel back where it was
+    Pimoroni_11x7matrix other;
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , other.resume( 0x75 ) );
+
+    for ( uint8_t x = 0 ; x < 11 ; x++ ) {
+
+        TEST_ASSERT_EQUAL_UINT8( 1 , other.pixelGet( x , x % 7 ) );
+        TEST_ASSERT_EQUAL_UINT8( 1 , other.pixelBlinkGet( x , ( x + 1 ) % 7 ) );
+        TEST_ASSERT_EQUAL_UINT8( 0x10 + x , other.pixelpwmGet( x , x % 7 ) );
+
+    }
+
+}
+
+
+// a chip that is not there is reported, not waited on.
+void test_matrix_missing_chip() {
+
+    Pimoroni_11x7matrix matrix;
+
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_ERROR_ADDRESS_NACK , matrix.begin( 0x77 ) );
+
+}
+
+
+// a frame comes back in x order, whatever order the chip keeps the columns in.
+void test_matrix_frame_readback() {
+
+    Pimoroni_11x7matrix matrix;
+    matrix.begin( 0x75 );
+
+    const uint8_t chipindex[ 11 ] = { 0 , 2 , 4 , 6 , 8 , 10 , 1 , 3 , 5 , 7 , 9 };
+
+    for ( uint8_t x = 0 ; x < 11 ; x++ ) {
+
+        chip.frameRegisterSet( 4 , 0x00 + chipindex[ x ] , x + 1 );
+        chip.frameRegisterSet( 4 , 0x12 + chipindex[ x ] , x + 0x20 );
+
+        for ( uint8_t y = 0 ; y < 8 ; y++ ) { chip.frameRegisterSet( 4 , 0x24 + chipindex[ x ] * 8 + y , ( x << 4 ) | y ); }
+
+    }
+
+    Pimoroni_11x7matrixFrameBuffer buffer;
+    Wire.statsReset();
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.frameReadback( 4 , &buffer ) );
+
+    for ( uint8_t x = 0 ; x < 11 ; x++ ) {
+
+        TEST_ASSERT_EQUAL_HEX8( x + 1 , buffer.state[ x ] );
+        TEST_ASSERT_EQUAL_HEX8( x + 0x20 , buffer.blink[ x ] );
+
+        for ( uint8_t y = 0 ; y < 7 ; y++ ) { TEST_ASSERT_EQUAL_HEX8( ( x << 4 ) | y , buffer.pwm[ x ][ y ] ); }
+
+    }
+
+    // page select, the register address, then 4 reads
+    TEST_ASSERT_EQUAL_UINT32( 6 , Wire.statsGet().transactions );
+
+}
+
+
+// the shadow copy catches up with a chip changed behind the driver's back, keeping what is waiting for commit().
+void test_matrix_control_readback() {
+
+    Pimoroni_11x7matrix matrix;
+    matrix.begin( 0x75 );
+
+    IS31FL3731 other;
+    other.i2caddressset( 0x75 );
+
+    other.write( IS31FL3731_PAGE_CONTROL , 0x05 , 0x03 );
+    TEST_ASSERT_EQUAL_UINT8( 0 , matrix.blinkPeriodTimeGet() );
+
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.controlRegisterReadback() );
+    TEST_ASSERT_EQUAL_UINT8( 3 , matrix.blinkPeriodTimeGet() );
+
+    // a change waiting for commit() wins over what the chip has
+    matrix.beginUpdate();
+    matrix.autoplayFrameDelayTimeSet( 7 );
+    other.write( IS31FL3731_PAGE_CONTROL , 0x03 , 0x02 );
+    other.write( IS31FL3731_PAGE_CONTROL , 0x05 , 0x04 );
+
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.controlRegisterReadback() );
+    TEST_ASSERT_EQUAL_UINT8( 7 , matrix.autoplayFrameDelayTimeGet() );
+    TEST_ASSERT_EQUAL_UINT8( 4 , matrix.blinkPeriodTimeGet() );
+
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.commit() );
+    TEST_ASSERT_EQUAL_HEX8( 0x07 , chip.controlRegisterGet( 0x03 ) );
+
+    // a readback doesn't clear the frame interrupt
+    other.write( IS31FL3731_PAGE_CONTROL , 0x02 , 0b00010010 );
+    other.write( IS31FL3731_PAGE_CONTROL , 0x03 , 0x01 );
+    other.write( IS31FL3731_PAGE_CONTROL , 0x00 , 0b00001000 );
+    delay( 30 );
+
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.controlRegisterReadback() );
+    TEST_ASSERT_EQUAL_UINT8( 1 , matrix.frameDisplayInterruptGet() );
+
+}
+
+
+// the usual wire transport, with a chip that holds the clock on reads and a bus that can be stuck.
+// the driver keeps its own copy of the transport, so the knobs are shared.
+struct StretchTransportState {
+
+    /// @brief How long each read keeps the bytes back, in microseconds.
+    uint32_t stretch;
+
+    /// @brief When the last read started, on the simulated clock.
+    uint32_t readstart;
+
+    /// @brief 1 if recover() finds the bus still held low.
+    uint8_t stuck;
+
+    /// @brief How many times recover() was called.
+    uint8_t recovers;
+
+    /// @brief The last timeout the driver handed over.
+    uint32_t timeout;
+
+};
+
+StretchTransportState stretchstate;
+
+class StretchTransport : public Pimoroni_11x7matrixWireTransport {
+
+    public:
+
+    void timeoutSet( uint32_t microseconds ) { stretchstate.timeout = microseconds; }
+
+    uint8_t requestFrom( uint8_t address , uint8_t count ) {
+
+        stretchstate.readstart = micros();
+        return Pimoroni_11x7matrixWireTransport::requestFrom( address , count );
+
+    }
+
+    // a microsecond goes by each time the driver looks
+    int available() {
+
+        delayMicroseconds( 1 );
+        if ( micros() - stretchstate.readstart < stretchstate.stretch ) { return 0; }
+        return Pimoroni_11x7matrixWireTransport::available();
+
+    }
+
+    uint8_t recover() { stretchstate.recovers++; return stretchstate.stuck; }
+
+};
+
+
+// a read held up past the timeout gives up, and busRecover() gets the bus going again.
+void test_matrix_timeout_recover() {
+
+    stretchstate.stretch = 0;
+    stretchstate.stuck = 0;
+    stretchstate.recovers = 0;
+
+    Pimoroni_11x7matrixT< StretchTransport > matrix;
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.begin( 0x75 ) );
+
+    matrix.timeoutSet( 100 );
+    TEST_ASSERT_EQUAL_UINT32( 100 , matrix.timeoutGet() );
+    TEST_ASSERT_EQUAL_UINT32( 100 , stretchstate.timeout );
+
+    // held up for less than the timeout is fine
+    stretchstate.stretch = 50;
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.controlRegisterReadback() );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.lastStatusGet() );
+
+    // longer is not, and it gives up about when it said it would
+    stretchstate.stretch = 500;
+    uint32_t starttime = micros();
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_ERROR_TIMEOUT , matrix.controlRegisterReadback() );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_ERROR_TIMEOUT , matrix.lastStatusGet() );
+    TEST_ASSERT_LESS_THAN_UINT32( 500 , micros() - starttime );
+
+    // a bus that will not let go says so
+    stretchstate.stretch = 0;
+    stretchstate.stuck = 1;
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_ERROR_BUS_STUCK , matrix.busRecover() );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_ERROR_BUS_STUCK , matrix.lastStatusGet() );
+
+    // once it does, the timeout is put back and the page is selected again on the next transfer
+    stretchstate.stuck = 0;
+    stretchstate.timeout = 0;
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.busRecover() );
+    TEST_ASSERT_EQUAL_UINT8( 2 , stretchstate.recovers );
+    TEST_ASSERT_EQUAL_UINT32( 100 , stretchstate.timeout );
+
+    chip.countReset();
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.blinkPeriodTimeSet( 2 ) );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.lastStatusGet() );
+    TEST_ASSERT_EQUAL_UINT32( 1 , chip.pageSelectCountGet() );
+    TEST_ASSERT_EQUAL_HEX8( 0x02 , chip.controlRegisterGet( 0x05 ) );
+
+    // and a chip that is not there at all is a nack, not a timeout
+    chip.maxClockSet( 50000 );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_ERROR_ADDRESS_NACK , matrix.controlRegisterReadback() );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_ERROR_ADDRESS_NACK , matrix.lastStatusGet() );
+
+}
+
+
+// what the pusher's callback was told
+uint8_t pushcalls;
+uint8_t pushframe;
+uint8_t pushstatus;
+
+void pushDone( uint8_t framenumber , uint8_t status ) {
+
+    pushcalls++;
+    pushframe = framenumber;
+    pushstatus = status;
+
+}
+
+
+// the pusher sends a snapshot one transaction a poll, and a bus error leaves the frame for the matrix to repair.
+void test_pusher_stream() {
+
+    Pimoroni_11x7matrix matrix;
+    matrix.begin( 0x75 );
+
+    Pimoroni_11x7matrixPusher pusher;
+    pushcalls = 0;
+
+    matrix.pixelSet( 0 , 0 , 1 );
+    matrix.pixelpwmSet( 10 , 6 , 0x80 );
+
+    TEST_ASSERT_EQUAL_UINT8( 1 , pusher.queue( matrix , 2 , pushDone ) );
+    TEST_ASSERT_EQUAL_UINT8( 1 , pusher.busy() );
+
+    // one frame at a time
+    TEST_ASSERT_EQUAL_UINT8( 0 , pusher.queue( matrix , 3 , pushDone ) );
+
+    // drawing carries on without touching what was queued
+    matrix.pixelSet( 0 , 0 , 0 );
+    matrix.pixelSet( 1 , 0 , 1 );
+
+    // blocking writes keep off the frame going out, and leave what they would have sent dirty
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_ERROR_BUSY , matrix.pixelBufferWriteAllToFrame( 2 ) );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_ERROR_BUSY , matrix.pixelBufferStateWriteToFrame( 2 ) );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_ERROR_BUSY , matrix.lastStatusGet() );
+    TEST_ASSERT_EQUAL_HEX8( 0x00 , chip.frameRegisterGet( 2 , 0x02 ) );
+
+    // but other frames are fine
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.pixelBufferStateWriteToFrame( 4 ) );
+    TEST_ASSERT_EQUAL_HEX8( 0b00000001 , chip.frameRegisterGet( 4 , 0x02 ) );
+
+    uint8_t polls = 0;
+    uint8_t more = 1;
+
+    while ( more && ( polls < 100 ) ) {
+
+        Wire.statsReset();
+        more = pusher.poll();
+        polls++;
+
+        TEST_ASSERT_LESS_THAN_UINT32( 2 , Wire.statsGet().transactions );
+        TEST_ASSERT_LESS_THAN_UINT32( BUFFER_LENGTH + 1 , Wire.statsGet().byteswritten );
+
+    }
+
+    TEST_ASSERT_EQUAL_UINT8( 0 , pusher.busy() );
+    TEST_ASSERT_EQUAL_UINT8( 1 , pushcalls );
+    TEST_ASSERT_EQUAL_UINT8( 2 , pushframe );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , pushstatus );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , pusher.statusGet() );
+
+    TEST_ASSERT_EQUAL_HEX8( 0b00000001 , chip.frameRegisterGet( 2 , 0x00 ) );
+    TEST_ASSERT_EQUAL_HEX8( 0x00 , chip.frameRegisterGet( 2 , 0x02 ) );
+    TEST_ASSERT_EQUAL_HEX8( 0x80 , chip.frameRegisterGet( 2 , 0x24 + 9 * 8 + 6 ) );
+
+    // idle, so polling does nothing
+    Wire.statsReset();
+    TEST_ASSERT_EQUAL_UINT8( 0 , pusher.poll() );
+    TEST_ASSERT_EQUAL_UINT32( 0 , Wire.statsGet().transactions );
+    TEST_ASSERT_EQUAL_UINT8( 1 , pushcalls );
+
+    // what was drawn after the queue() is still dirty for the frame
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.pixelBufferWriteAllToFrame( 2 ) );
+    TEST_ASSERT_EQUAL_HEX8( 0x00 , chip.frameRegisterGet( 2 , 0x00 ) );
+    TEST_ASSERT_EQUAL_HEX8( 0b00000001 , chip.frameRegisterGet( 2 , 0x02 ) );
+
+    // a bus error part way through stops the frame
+    matrix.pixelBufferStateFill( 0x7F );
+    matrix.pixelBufferpwmStateFill( 0x40 );
+
+    TEST_ASSERT_EQUAL_UINT8( 1 , pusher.queue( matrix , 3 , pushDone ) );
+    TEST_ASSERT_EQUAL_UINT8( 1 , pusher.poll() );
+    TEST_ASSERT_EQUAL_UINT8( 1 , pusher.poll() );
+    TEST_ASSERT_EQUAL_HEX8( 0x7F , chip.frameRegisterGet( 3 , 0x00 ) );
+
+    chip.maxClockSet( 50000 );
+    TEST_ASSERT_EQUAL_UINT8( 0 , pusher.poll() );
+    chip.maxClockSet( IS31FL3731_SIM_DEFAULT_MAX_CLOCK );
+
+    TEST_ASSERT_EQUAL_UINT8( 0 , pusher.busy() );
+    TEST_ASSERT_EQUAL_UINT8( 2 , pushcalls );
+    TEST_ASSERT_EQUAL_UINT8( 3 , pushframe );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_ERROR_ADDRESS_NACK , pushstatus );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_ERROR_ADDRESS_NACK , pusher.statusGet() );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_ERROR_VERIFY , matrix.pixelBufferVerifyFrame( 3 ) );
+
+    // and the matrix sends it all again
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.pixelBufferWriteAllToFrame( 3 ) );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.pixelBufferVerifyFrame( 3 ) );
+
+}
+
+
+// a control register the chip never got is sent again by the next commit().
+void test_matrix_control_write_failure() {
+
+    Pimoroni_11x7matrix matrix;
+    matrix.begin( 0x75 );
+
+    chip.maxClockSet( 50000 );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_ERROR_ADDRESS_NACK , matrix.blinkPeriodTimeSet( 5 ) );
+    chip.maxClockSet( IS31FL3731_SIM_DEFAULT_MAX_CLOCK );
+
+    TEST_ASSERT_EQUAL_HEX8( 0x00 , chip.controlRegisterGet( 0x05 ) );
+
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.commit() );
+
+    TEST_ASSERT_EQUAL_HEX8( 0x05 , chip.controlRegisterGet( 0x05 ) );
+    TEST_ASSERT_EQUAL_UINT8( 5 , matrix.blinkPeriodTimeGet() );
+
+}
+
+
+// updates nest, the outermost commit() sends everything in one transaction, and a failed one is sent again.
+void test_matrix_update_commit() {
+
+    Pimoroni_11x7matrix matrix;
+    matrix.begin( 0x75 );
+
+    chip.countReset();
+    Wire.statsReset();
+
+    matrix.beginUpdate();
+    matrix.beginUpdate();
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.autoplayFrameDelayTimeSet( 5 ) );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.blinkPeriodTimeSet( 3 ) );
+
+    // the inner one sends nothing
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.commit() );
+    TEST_ASSERT_EQUAL_UINT32( 0 , Wire.statsGet().transactions );
+    TEST_ASSERT_EQUAL_HEX8( 0x00 , chip.controlRegisterGet( 0x03 ) );
+
+    // the outer one sends 0x03 to 0x05 in one go, begin() left the control page selected
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.commit() );
+    TEST_ASSERT_EQUAL_UINT32( 1 , Wire.statsGet().transactions );
+    TEST_ASSERT_EQUAL_UINT32( 3 , chip.registerWriteCountGet() );
+    TEST_ASSERT_EQUAL_HEX8( 0x05 , chip.controlRegisterGet( 0x03 ) );
+    TEST_ASSERT_EQUAL_HEX8( 0x03 , chip.controlRegisterGet( 0x05 ) );
+
+    // a failed commit is retried by the next one
+    matrix.beginUpdate();
+    matrix.autoplayFrameDelayTimeSet( 7 );
+    chip.maxClockSet( 50000 );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_ERROR_ADDRESS_NACK , matrix.commit() );
+    chip.maxClockSet( IS31FL3731_SIM_DEFAULT_MAX_CLOCK );
+    TEST_ASSERT_EQUAL_HEX8( 0x05 , chip.controlRegisterGet( 0x03 ) );
+
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.commit() );
+    TEST_ASSERT_EQUAL_HEX8( 0x07 , chip.controlRegisterGet( 0x03 ) );
+    TEST_ASSERT_EQUAL_UINT8( 7 , matrix.autoplayFrameDelayTimeGet() );
+
+    // and after that there is nothing left to send
+    Wire.statsReset();
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.commit() );
+    TEST_ASSERT_EQUAL_UINT32( 0 , Wire.statsGet().transactions );
+
+}
+
+
+// the instrumentation counts each public call's bus traffic towards that call.
+void test_matrix_instrumentation() {
+
+    Pimoroni_11x7matrix matrix;
+    matrix.begin( 0x75 );
+    matrix.instrumentationReset();
+
+    Wire.statsReset();
+
+    // one state column, begin() left the chip on the control page
+    matrix.pixelSet( 0 , 0 , 1 );
+    matrix.pixelBufferStateWriteToFrame( 0 );
+
+    Pimoroni_11x7matrixInstrumentation counters;
+    matrix.instrumentationGet( PIMORONI_11X7MATRIX_API_WRITE_STATE , &counters );
+
+    TwoWireStats stats = Wire.statsGet();
+
+    TEST_ASSERT_EQUAL_UINT32( 1 , counters.calls );
+    TEST_ASSERT_EQUAL_UINT32( stats.transactions , counters.transactions );
+    TEST_ASSERT_EQUAL_UINT32( stats.byteswritten , counters.byteswritten );
+    TEST_ASSERT_EQUAL_UINT32( (uint32_t)( stats.nanoseconds / 1000 ) , counters.micros );
+    TEST_ASSERT_EQUAL_UINT32( 1 , counters.pageswitches );
+    TEST_ASSERT_EQUAL_UINT32( 0 , counters.pageswitchesavoided );
+
+    // the second one finds frame 0 already selected
+    matrix.pixelSet( 1 , 0 , 1 );
+    matrix.pixelBufferStateWriteToFrame( 0 );
+    matrix.instrumentationGet( PIMORONI_11X7MATRIX_API_WRITE_STATE , &counters );
+
+    TEST_ASSERT_EQUAL_UINT32( 2 , counters.calls );
+    TEST_ASSERT_EQUAL_UINT32( 1 , counters.pageswitches );
+    TEST_ASSERT_EQUAL_UINT32( 1 , counters.pageswitchesavoided );
+
+    // the setters and uploads inside begin() count towards begin()
+    matrix.begin( 0x75 );
+    matrix.instrumentationGet( PIMORONI_11X7MATRIX_API_CONTROL_SET , &counters );
+    TEST_ASSERT_EQUAL_UINT32( 0 , counters.calls );
+    matrix.instrumentationGet( PIMORONI_11X7MATRIX_API_BEGIN , &counters );
+    TEST_ASSERT_EQUAL_UINT32( 1 , counters.calls );
+
+    // starting double buffering isn't a present()
+    matrix.doubleBufferBegin( 2 , 3 );
+    matrix.instrumentationGet( PIMORONI_11X7MATRIX_API_DOUBLE_BUFFER , &counters );
+    TEST_ASSERT_EQUAL_UINT32( 1 , counters.calls );
+    TEST_ASSERT_EQUAL_UINT32( 1 , counters.transactions );
+    matrix.instrumentationGet( PIMORONI_11X7MATRIX_API_PRESENT , &counters );
+    TEST_ASSERT_EQUAL_UINT32( 0 , counters.calls );
+
+}
+
+
+
+// present() draws into the hidden frame, then flips to it.
+void test_matrix_double_buffer() {
+
+    Pimoroni_11x7matrix matrix;
+    matrix.begin( 0x75 );
+
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.doubleBufferBegin( 0 , 1 ) );
+    TEST_ASSERT_EQUAL_UINT8( 1 , matrix.backFrameGet() );
+
+    matrix.pixelSet( 0 , 0 , 1 );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.present() );
+
+    TEST_ASSERT_EQUAL_UINT8( 1 , chip.displayedFrameGet() );
+    TEST_ASSERT_EQUAL_UINT8( 0b00000001 , chip.frameRegisterGet( 1 , 0x00 ) );
+    TEST_ASSERT_EQUAL_UINT8( 0x00 , chip.frameRegisterGet( 0 , 0x00 ) );
+    TEST_ASSERT_EQUAL_UINT8( 0 , matrix.backFrameGet() );
+
+    // frame 0 catches up on both changes, and only the changed column goes out
+    matrix.pixelSet( 0 , 1 , 1 );
+    Wire.statsReset();
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.present() );
+
+    TEST_ASSERT_EQUAL_UINT8( 0 , chip.displayedFrameGet() );
+    TEST_ASSERT_EQUAL_UINT8( 0b00000011 , chip.frameRegisterGet( 0 , 0x00 ) );
+    TEST_ASSERT_EQUAL_UINT8( 0b00000001 , chip.frameRegisterGet( 1 , 0x00 ) );
+
+    // page select, one column, page select, display pointer
+    TEST_ASSERT_EQUAL_UINT32( 4 , Wire.statsGet().transactions );
+
+    // a failed upload leaves the display alone
+    chip.maxClockSet( 50000 );
+    matrix.pixelSet( 0 , 2 , 1 );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_ERROR_ADDRESS_NACK , matrix.present() );
+    chip.maxClockSet( IS31FL3731_SIM_DEFAULT_MAX_CLOCK );
+    TEST_ASSERT_EQUAL_UINT8( 0 , chip.displayedFrameGet() );
+    TEST_ASSERT_EQUAL_UINT8( 1 , matrix.backFrameGet() );
+
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.present() );
+    TEST_ASSERT_EQUAL_UINT8( 1 , chip.displayedFrameGet() );
+    TEST_ASSERT_EQUAL_UINT8( 0b00000111 , chip.frameRegisterGet( 1 , 0x00 ) );
+
+    // inside an update the flip still happens straight away, so the frames never swap behind the display's back
+    matrix.beginUpdate();
+    matrix.autoplayFrameDelayTimeSet( 7 );
+    matrix.pixelSet( 0 , 3 , 1 );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.present() );
+    TEST_ASSERT_EQUAL_UINT8( 0 , chip.displayedFrameGet() );
+    TEST_ASSERT_EQUAL_UINT8( 1 , matrix.backFrameGet() );
+    TEST_ASSERT_EQUAL_UINT8( 0b00001111 , chip.frameRegisterGet( 0 , 0x00 ) );
+
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.present() );
+    TEST_ASSERT_EQUAL_UINT8( 1 , chip.displayedFrameGet() );
+    TEST_ASSERT_EQUAL_HEX8( 0x00 , chip.controlRegisterGet( 0x03 ) );
+
+    // and commit() only sends the rest, leaving the display where present() put it
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.commit() );
+    TEST_ASSERT_EQUAL_HEX8( 0x07 , chip.controlRegisterGet( 0x03 ) );
+    TEST_ASSERT_EQUAL_UINT8( 1 , chip.displayedFrameGet() );
+    TEST_ASSERT_EQUAL_UINT8( 0 , matrix.backFrameGet() );
+
+}
+
+
+// in brightness only mode the state bits go out once, then a fade is pwm alone.
+void test_matrix_brightness_only() {
+
+    Pimoroni_11x7matrix matrix;
+    matrix.begin( 0x75 );
+
+    matrix.pixelSet( 0 , 0 , 1 );
+    matrix.pixelpwmSet( 0 , 0 , 0x40 );
+    matrix.pixelpwmSet( 0 , 1 , 0x40 );
+
+    // the pixel that was off is given pwm 0, so nothing changes on display
+    matrix.brightnessOnlyBegin();
+    TEST_ASSERT_EQUAL_UINT8( 1 , matrix.brightnessOnlyGet() );
+    TEST_ASSERT_EQUAL_UINT8( 0x40 , matrix.pixelpwmGet( 0 , 0 ) );
+    TEST_ASSERT_EQUAL_UINT8( 0x00 , matrix.pixelpwmGet( 0 , 1 ) );
+
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.pixelBufferWriteAllToFrame( 0 ) );
+
+    for ( uint8_t chipindex = 0 ; chipindex < 11 ; chipindex++ ) {
+
+        TEST_ASSERT_EQUAL_HEX8( 0x7F , chip.frameRegisterGet( 0 , 0x00 + chipindex ) );
+
+    }
+
+    // each step of a fade is one pwm run, the state is never sent again
+    for ( uint8_t step = 1 ; step < 4 ; step++ ) {
+
+        matrix.pixelpwmSet( 0 , 0 , 0x40 * step );
+        matrix.pixelSet( 0 , 1 , step & 0b00000001 );
+
+        Wire.statsReset();
+        TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.pixelBufferWriteAllToFrame( 0 ) );
+        TEST_ASSERT_EQUAL_UINT32( 1 , Wire.statsGet().transactions );
+
+        TEST_ASSERT_EQUAL_HEX8( 0x40 * step , chip.frameRegisterGet( 0 , 0x24 + 0 ) );
+        TEST_ASSERT_EQUAL_HEX8( ( step & 0b00000001 ) ? 0xFF : 0x00 , chip.frameRegisterGet( 0 , 0x24 + 1 ) );
+        TEST_ASSERT_EQUAL_HEX8( 0x7F , chip.frameRegisterGet( 0 , 0x00 ) );
+
+        TEST_ASSERT_EQUAL_UINT8( step & 0b00000001 , matrix.pixelGet( 0 , 1 ) );
+
+    }
+
+    // clearing leaves the state on for next time
+    matrix.pixelBufferClearAll();
+    TEST_ASSERT_EQUAL_UINT8( 0 , matrix.pixelGet( 0 , 0 ) );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.pixelBufferWriteAllToFrame( 0 ) );
+    TEST_ASSERT_EQUAL_HEX8( 0x7F , chip.frameRegisterGet( 0 , 0x00 ) );
+    TEST_ASSERT_EQUAL_HEX8( 0x00 , chip.frameRegisterGet( 0 , 0x24 + 0 ) );
+
+    // and leaving the mode puts the state back from the pwm
+    matrix.pixelpwmSet( 3 , 2 , 0x10 );
+    matrix.brightnessOnlyEnd();
+    TEST_ASSERT_EQUAL_UINT8( 1 , matrix.pixelGet( 3 , 2 ) );
+    TEST_ASSERT_EQUAL_UINT8( 0 , matrix.pixelGet( 3 , 3 ) );
+
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.pixelBufferWriteAllToFrame( 0 ) );
+    TEST_ASSERT_EQUAL_HEX8( 0b00000100 , chip.frameRegisterGet( 0 , 0x00 + 6 ) );
+    TEST_ASSERT_EQUAL_HEX8( 0x00 , chip.frameRegisterGet( 0 , 0x00 ) );
+
+}
+
+
+// gamma and master brightness change what is sent, never what is stored.
+void test_matrix_gamma() {
+
+    Pimoroni_11x7matrix matrix;
+    matrix.begin( 0x75 );
+
+    matrix.pixelpwmSet( 0 , 0 , 128 );
+    matrix.pixelpwmSet( 0 , 1 , 1 );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.pixelBufferWriteAllToFrame( 0 ) );
+    TEST_ASSERT_EQUAL_UINT8( 128 , chip.frameRegisterGet( 0 , 0x24 + 0 ) );
+
+    // turning it on resends the pwm, through the curve
+    matrix.gammaEnableSet( 1 );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.pixelBufferWriteAllToFrame( 0 ) );
+    TEST_ASSERT_EQUAL_UINT8( 128 , matrix.pixelpwmGet( 0 , 0 ) );
+    TEST_ASSERT_EQUAL_UINT8( 56 , chip.frameRegisterGet( 0 , 0x24 + 0 ) );
+    TEST_ASSERT_EQUAL_UINT8( 1 , chip.frameRegisterGet( 0 , 0x24 + 1 ) );
+    TEST_ASSERT_EQUAL_UINT8( 0 , chip.frameRegisterGet( 0 , 0x24 + 2 ) );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.pixelBufferVerifyFrame( 0 ) );
+
+    // half brightness is scaled before the curve
+    matrix.masterBrightnessSet( 127 );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.pixelBufferWriteAllToFrame( 0 ) );
+    TEST_ASSERT_EQUAL_UINT8( 12 , chip.frameRegisterGet( 0 , 0x24 + 0 ) );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.pixelBufferVerifyFrame( 0 ) );
+
+    // and without the curve it is just scaled
+    matrix.gammaEnableSet( 0 );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.pixelBufferWriteAllToFrame( 0 ) );
+    TEST_ASSERT_EQUAL_UINT8( 64 , chip.frameRegisterGet( 0 , 0x24 + 0 ) );
+
+    // back to full, everything goes out as stored
+    matrix.masterBrightnessSet( 255 );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.pixelBufferWriteAllToFrame( 0 ) );
+    TEST_ASSERT_EQUAL_UINT8( 128 , chip.frameRegisterGet( 0 , 0x24 + 0 ) );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.pixelBufferVerifyFrame( 0 ) );
+
+}
+
+
+// a board mounted the other way round is drawn the right way up.
+void test_matrix_orientation() {
+
+    Pimoroni_11x7matrix matrix;
+    matrix.begin( 0x75 );
+
+    // a quarter turn won't fit
+    TEST_ASSERT_EQUAL_UINT8( 0 , matrix.orientationSet( PIMORONI_11X7MATRIX_ROTATE_90 ) );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_ROTATE_0 , matrix.orientationGet() );
+
+    // mirrored, x 0 is the chip's x 10, the last column it sees
+    TEST_ASSERT_EQUAL_UINT8( 1 , matrix.orientationSet( PIMORONI_11X7MATRIX_FLIP_X ) );
+    matrix.pixelSet( 0 , 1 , 1 );
+    matrix.pixelpwmSet( 0 , 1 , 0x20 );
+    TEST_ASSERT_EQUAL_UINT8( 1 , matrix.pixelGet( 0 , 1 ) );
+
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.pixelBufferWriteAllToFrame( 0 ) );
+    TEST_ASSERT_EQUAL_HEX8( 0b00000010 , chip.frameRegisterGet( 0 , 0x00 + 9 ) );
+    TEST_ASSERT_EQUAL_HEX8( 0x20 , chip.frameRegisterGet( 0 , 0x24 + 9 * 8 + 1 ) );
+
+    // upside down, 0,0 is the chip's top right
+    matrix.pixelBufferClearAll();
+    TEST_ASSERT_EQUAL_UINT8( 1 , matrix.orientationSet( PIMORONI_11X7MATRIX_ROTATE_180 ) );
+    matrix.pixelSet( 0 , 0 , 1 );
+    matrix.pixelBlinkSet( 6 , 0 , 1 );
+
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.pixelBufferWriteAllToFrame( 0 ) );
+    TEST_ASSERT_EQUAL_HEX8( 0b01000000 , chip.frameRegisterGet( 0 , 0x00 + 9 ) );
+    TEST_ASSERT_EQUAL_HEX8( 0b01000000 , chip.frameRegisterGet( 0 , 0x12 + 8 ) );
+
+    // and 180 flipped both ways is the right way up again
+    TEST_ASSERT_EQUAL_UINT8( 1 , matrix.orientationSet( PIMORONI_11X7MATRIX_ROTATE_180 | PIMORONI_11X7MATRIX_FLIP_X | PIMORONI_11X7MATRIX_FLIP_Y ) );
+    TEST_ASSERT_EQUAL_UINT8( 1 , matrix.pixelGet( 10 , 6 ) );
+
+}
+
+
+// shapes go in a column at a time, blended with what is there.
+void test_draw_shapes() {
+
+    Pimoroni_11x7matrix matrix;
+    matrix.begin( 0x75 );
+
+    Pimoroni_11x7matrixDraw draw( matrix );
+
+    // a rectangle clipped at the right hand edge
+    draw.fillRect( 9 , 1 , 5 , 2 );
+    for ( uint8_t x = 0 ; x < 11 ; x++ ) {
+
+        TEST_ASSERT_EQUAL_UINT8( x >= 9 , matrix.pixelGet( x , 1 ) );
+        TEST_ASSERT_EQUAL_UINT8( x >= 9 , matrix.pixelGet( x , 2 ) );
+        TEST_ASSERT_EQUAL_UINT8( 0 , matrix.pixelGet( x , 3 ) );
+
+    }
+
+    // a column replaces, a row only touches its own row
+    draw.columnSet( 9 , 0b1010000 );
+    TEST_ASSERT_EQUAL_UINT8( 0 , matrix.pixelGet( 9 , 1 ) );
+    TEST_ASSERT_EQUAL_UINT8( 1 , matrix.pixelGet( 9 , 6 ) );
+    draw.rowSet( 0 , 0b10000000001 );
+    TEST_ASSERT_EQUAL_UINT8( 1 , matrix.pixelGet( 0 , 0 ) );
+    TEST_ASSERT_EQUAL_UINT8( 1 , matrix.pixelGet( 10 , 0 ) );
+    TEST_ASSERT_EQUAL_UINT8( 1 , matrix.pixelGet( 10 , 1 ) );
+
+    // xor inverts, and clear rubs out
+    draw.blendModeSet( PIMORONI_11X7MATRIX_DRAW_XOR );
+    draw.fillRect( 0 , 0 , 11 , 1 );
+    TEST_ASSERT_EQUAL_UINT8( 0 , matrix.pixelGet( 0 , 0 ) );
+    TEST_ASSERT_EQUAL_UINT8( 1 , matrix.pixelGet( 5 , 0 ) );
+    draw.blendModeSet( PIMORONI_11X7MATRIX_DRAW_CLEAR );
+    draw.fillRect( 0 , 0 , 11 , 7 );
+    for ( uint8_t x = 0 ; x < 11 ; x++ ) { TEST_ASSERT_EQUAL_UINT8( 0 , matrix.pixelGet( x , 0 ) ); }
+
+    // and keeps only what the column mask has on
+    draw.blendModeSet( PIMORONI_11X7MATRIX_DRAW_OR );
+    draw.columnSet( 4 , 0b0000111 );
+    draw.blendModeSet( PIMORONI_11X7MATRIX_DRAW_AND );
+    draw.columnSet( 4 , 0b0000110 );
+    TEST_ASSERT_EQUAL_UINT8( 0 , matrix.pixelGet( 4 , 0 ) );
+    TEST_ASSERT_EQUAL_UINT8( 1 , matrix.pixelGet( 4 , 1 ) );
+
+    // a shallow line, one pixel per column, every column once
+    draw.blendModeSet( PIMORONI_11X7MATRIX_DRAW_SET );
+    matrix.pixelBufferClearAll();
+    draw.line( 0 , 0 , 10 , 5 );
+    for ( uint8_t x = 0 ; x < 11 ; x++ ) {
+
+        uint8_t count = 0;
+        for ( uint8_t y = 0 ; y < 7 ; y++ ) { count += matrix.pixelGet( x , y ); }
+        TEST_ASSERT_EQUAL_UINT8( 1 , count );
+
+    }
+    TEST_ASSERT_EQUAL_UINT8( 1 , matrix.pixelGet( 0 , 0 ) );
+    TEST_ASSERT_EQUAL_UINT8( 1 , matrix.pixelGet( 10 , 5 ) );
+
+    // a steep one backwards fills its column
+    matrix.pixelBufferClearAll();
+    draw.line( 3 , 6 , 3 , 0 );
+    for ( uint8_t y = 0 ; y < 7 ; y++ ) { TEST_ASSERT_EQUAL_UINT8( 1 , matrix.pixelGet( 3 , y ) ); }
+
+    // pwm spans, drawn the way up the matrix is
+    matrix.orientationSet( PIMORONI_11X7MATRIX_ROTATE_180 );
+    draw.pwmFillRect( 0 , 0 , 2 , 2 , 0x30 );
+    draw.pwmLine( 0 , 6 , 2 , 6 , 0x50 );
+    draw.pwmRowSet( 4 , 0b100 , 0x60 );
+    TEST_ASSERT_EQUAL_UINT8( 0x30 , matrix.pixelpwmGet( 1 , 1 ) );
+    TEST_ASSERT_EQUAL_UINT8( 0x00 , matrix.pixelpwmGet( 2 , 2 ) );
+    TEST_ASSERT_EQUAL_UINT8( 0x50 , matrix.pixelpwmGet( 2 , 6 ) );
+    TEST_ASSERT_EQUAL_UINT8( 0x60 , matrix.pixelpwmGet( 2 , 4 ) );
+
+    draw.columnSet( 0 , 0b0000001 );
+    TEST_ASSERT_EQUAL_UINT8( 1 , matrix.pixelGet( 0 , 0 ) );
+    TEST_ASSERT_EQUAL_UINT8( 0 , matrix.pixelGet( 0 , 6 ) );
+
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.pixelBufferWriteAllToFrame( 0 ) );
+    TEST_ASSERT_EQUAL_HEX8( 0b01000000 , chip.frameRegisterGet( 0 , 0x00 + 9 ) );
+    TEST_ASSERT_EQUAL_HEX8( 0x30 , chip.frameRegisterGet( 0 , 0x24 + 9 * 8 + 6 ) );
+
+}
+
+
+// the matrix the player animation draws into
+Pimoroni_11x7matrix *playermatrix;
+
+// 20 frames, each one shows its own number in columns 0 and 6
+uint8_t playerFrameDraw( uint32_t index ) {
+
+    if ( index >= 20 ) { return 0; }
+
+    for ( uint8_t ypos = 0 ; ypos < 7 ; ypos++ ) {
+
+        playermatrix->pixelSet( 0 , ypos , ( index >> ypos ) & 1 );
+        playermatrix->pixelSet( 6 , ypos , ( index >> ( ypos + 7 ) ) & 1 );
+
+    }
+
+    return 1;
+
+}
+
+
+// the player streams an animation longer than the ring, never showing a frame out of order.
+void test_player_stream() {
+
+    Pimoroni_11x7matrix matrix;
+    matrix.begin( 0x75 );
+    playermatrix = &matrix;
+
+    Pimoroni_11x7matrixPlayer player( matrix );
+
+    // 2 x 11ms a frame
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , player.start( playerFrameDraw , 2 ) );
+    TEST_ASSERT_EQUAL_UINT32( 8 , player.framesDrawnGet() );
+
+    uint32_t lastindex = 0;
+
+    while ( player.poll() ) {
+
+        // whatever is showing is the frame after the last one we saw, or the same one
+        uint8_t slot = chip.displayedFrameGet();
+        uint32_t index = chip.frameRegisterGet( slot , 0x00 ) | ( chip.frameRegisterGet( slot , 0x01 ) << 7 );
+
+        TEST_ASSERT_TRUE( ( index == lastindex ) || ( index == lastindex + 1 ) );
+        lastindex = index;
+
+        delay( 5 );
+
+    }
+
+    // every frame got shown, not just the 8 the ring started with
+    TEST_ASSERT_GREATER_THAN_UINT32( 17 , lastindex );
+
+    // it ends holding the last frame, in picture mode
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , player.statusGet() );
+    TEST_ASSERT_EQUAL_UINT32( 20 , player.framesDrawnGet() );
+    TEST_ASSERT_EQUAL_UINT8( 0x00 , chip.controlRegisterGet( 0x00 ) & 0b00011000 );
+
+    uint8_t slot = chip.displayedFrameGet();
+    TEST_ASSERT_EQUAL_UINT8( 19 , chip.frameRegisterGet( slot , 0x00 ) );
+
+    // polled on time until the last frame is showing, then late.  the chip runs on past the end,
+    // into frames that held the last lap, and they have to be showing the last frame too.
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , player.start( playerFrameDraw , 2 ) );
+
+    uint8_t more = 1;
+
+    while ( more && ( chip.frameRegisterGet( chip.displayedFrameGet() , 0x00 ) != 19 ) ) {
+
+        more = player.poll();
+        delay( 5 );
+
+    }
+
+    TEST_ASSERT_EQUAL_UINT8( 1 , more );
+
+    for ( uint8_t late = 0 ; late < 5 ; late++ ) {
+
+        delay( 22 );
+
+        slot = chip.displayedFrameGet();
+        TEST_ASSERT_EQUAL_UINT8( 19 , chip.frameRegisterGet( slot , 0x00 ) );
+        TEST_ASSERT_EQUAL_UINT8( 0 , chip.frameRegisterGet( slot , 0x01 ) );
+
+    }
+
+    TEST_ASSERT_EQUAL_UINT8( 0 , player.poll() );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , player.statusGet() );
+    TEST_ASSERT_EQUAL_UINT8( 0x00 , chip.controlRegisterGet( 0x00 ) & 0b00011000 );
+    TEST_ASSERT_EQUAL_UINT8( 19 , chip.frameRegisterGet( chip.displayedFrameGet() , 0x00 ) );
+
+}
+
+
+// images stay in their frames, showing one again is just the display pointer.
+void test_framepool_lru() {
+
+    Pimoroni_11x7matrix matrix;
+    matrix.begin( 0x75 );
+
+    // frames 1-3, leaving 0 alone
+    Pimoroni_11x7matrixFramePool pool( matrix , 1 , 3 );
+
+    for ( uint8_t key = 10 ; key < 13 ; key++ ) {
+
+        TEST_ASSERT_FALSE( pool.resident( key ) );
+        matrix.pixelBufferClearAll();
+        matrix.pixelSet( key - 10 , 0 , 1 );
+        TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , pool.show( key ) );
+
+    }
+
+    TEST_ASSERT_EQUAL_UINT8( 3 , chip.displayedFrameGet() );
+    TEST_ASSERT_EQUAL_UINT8( 0b00000001 , chip.frameRegisterGet( 1 , 0x00 ) );
+
+    // a resident image is one write of the pointer, the last show() left the chip on the control page
+    Wire.statsReset();
+    TEST_ASSERT_TRUE( pool.resident( 10 ) );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , pool.show( 10 ) );
+    TEST_ASSERT_EQUAL_UINT8( 1 , chip.displayedFrameGet() );
+    TEST_ASSERT_EQUAL_UINT32( 1 , Wire.statsGet().transactions );
+    TEST_ASSERT_EQUAL_UINT32( 2 , Wire.statsGet().byteswritten );
+
+    // and nothing at all if it is already showing
+    Wire.statsReset();
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , pool.show( 10 ) );
+    TEST_ASSERT_EQUAL_UINT32( 0 , Wire.statsGet().transactions );
+
+    // 11 is the least recently used now, so a new image goes over it
+    matrix.pixelBufferClearAll();
+    matrix.pixelSet( 5 , 5 , 1 );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , pool.show( 13 ) );
+    TEST_ASSERT_FALSE( pool.resident( 11 ) );
+    TEST_ASSERT_EQUAL_UINT8( 2 , chip.displayedFrameGet() );
+    TEST_ASSERT_EQUAL_UINT8( 0x00 , chip.frameRegisterGet( 0 , 0x00 ) );
+
+    TEST_ASSERT_EQUAL_UINT32( 2 , pool.hitCountGet() );
+    TEST_ASSERT_EQUAL_UINT32( 4 , pool.missCountGet() );
+
+    // keyed by content, drawing the same picture again finds it
+    matrix.pixelBufferClearAll();
+    matrix.pixelSet( 0 , 0 , 1 );
+    uint32_t hash = pool.pixelBufferHashGet();
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , pool.showBuffer() );
+
+    matrix.pixelSet( 0 , 0 , 0 );
+    TEST_ASSERT_TRUE( hash != pool.pixelBufferHashGet() );
+    matrix.pixelSet( 0 , 0 , 1 );
+    TEST_ASSERT_EQUAL_UINT32( hash , pool.pixelBufferHashGet() );
+    TEST_ASSERT_TRUE( pool.resident( hash ) );
+
+}
+
+
+// two boards side by side make one 22x7 canvas, and one flush fills both.
+void test_canvas_tiles() {
+
+    Pimoroni_11x7matrix left;
+    Pimoroni_11x7matrix right;
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , left.begin( 0x74 ) );
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , right.begin( 0x75 ) );
+
+    Pimoroni_11x7matrixCanvas canvas( 2 );
+    TEST_ASSERT_EQUAL_UINT8( 1 , canvas.tileSet( 0 , 0 , left ) );
+    TEST_ASSERT_EQUAL_UINT8( 1 , canvas.tileSet( 1 , 0 , right ) );
+    TEST_ASSERT_EQUAL_UINT8( 0 , canvas.tileSet( 0 , 1 , right ) );
+    TEST_ASSERT_EQUAL_UINT8( 22 , canvas.widthGet() );
+    TEST_ASSERT_EQUAL_UINT8( 7 , canvas.heightGet() );
+
+    // x 6 on the left board, and x 17 is x 6 on the right one
+    canvas.pixelSet( 6 , 2 , 1 );
+    canvas.pixelSet( 17 , 3 , 1 );
+    canvas.pixelpwmSet( 17 , 3 , 0x40 );
+    canvas.pixelSet( 22 , 0 , 1 );
+
+    TEST_ASSERT_EQUAL_UINT8( 1 , right.pixelGet( 6 , 3 ) );
+    TEST_ASSERT_EQUAL_UINT8( 0 , right.pixelGet( 6 , 2 ) );
+    TEST_ASSERT_EQUAL_UINT8( 0x40 , canvas.pixelpwmGet( 17 , 3 ) );
+    TEST_ASSERT_EQUAL_UINT8( 0 , canvas.pixelGet( 22 , 0 ) );
+
+    chipleft.countReset();
+    chip.countReset();
+
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , canvas.flush( 0 ) );
+
+    TEST_ASSERT_EQUAL_UINT8( 0b00000100 , chipleft.frameRegisterGet( 0 , 0x01 ) );
+    TEST_ASSERT_EQUAL_UINT8( 0b00001000 , chip.frameRegisterGet( 0 , 0x01 ) );
+    TEST_ASSERT_EQUAL_UINT8( 0x40 , chip.frameRegisterGet( 0 , 0x24 + 8 + 3 ) );
+
+    // one page select each, not one per run
+    TEST_ASSERT_EQUAL_UINT32( 1 , chipleft.pageSelectCountGet() );
+    TEST_ASSERT_EQUAL_UINT32( 1 , chip.pageSelectCountGet() );
+
+    // nothing left to send
+    Wire.statsReset();
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , canvas.flush( 0 ) );
+    TEST_ASSERT_EQUAL_UINT32( 0 , Wire.statsGet().transactions );
+
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , canvas.frameDisplayPointerSet( 0 ) );
+    TEST_ASSERT_EQUAL_UINT8( 0 , chipleft.displayedFrameGet() );
+
+}
+
+
+// a canvas turned a quarter is tall and thin.
+void test_canvas_orientation() {
+
+    Pimoroni_11x7matrix left;
+    Pimoroni_11x7matrix right;
+    left.begin( 0x74 );
+    right.begin( 0x75 );
+
+    Pimoroni_11x7matrixCanvas canvas( 2 );
+    canvas.tileSet( 0 , 0 , left );
+    canvas.tileSet( 1 , 0 , right );
+
+    canvas.orientationSet( PIMORONI_11X7MATRIX_ROTATE_90 );
+    TEST_ASSERT_EQUAL_UINT8( 7 , canvas.widthGet() );
+    TEST_ASSERT_EQUAL_UINT8( 22 , canvas.heightGet() );
+
+    // bottom left is the top of the left board, top right is the bottom of the right one
+    canvas.pixelSet( 0 , 0 , 1 );
+    canvas.pixelSet( 6 , 21 , 1 );
+    canvas.pixelSet( 7 , 0 , 1 );
+    TEST_ASSERT_EQUAL_UINT8( 1 , left.pixelGet( 0 , 6 ) );
+    TEST_ASSERT_EQUAL_UINT8( 1 , right.pixelGet( 10 , 0 ) );
+    TEST_ASSERT_EQUAL_UINT8( 1 , canvas.pixelGet( 6 , 21 ) );
+    TEST_ASSERT_EQUAL_UINT8( 0 , canvas.pixelGet( 7 , 0 ) );
+
+    // the other way, and mirrored
+    canvas.pixelBufferClearAll();
+    canvas.orientationSet( PIMORONI_11X7MATRIX_ROTATE_270 | PIMORONI_11X7MATRIX_FLIP_X );
+    canvas.pixelSet( 0 , 0 , 1 );
+    canvas.pixelSet( 0 , 21 , 1 );
+    TEST_ASSERT_EQUAL_UINT8( 1 , right.pixelGet( 10 , 6 ) );
+    TEST_ASSERT_EQUAL_UINT8( 1 , left.pixelGet( 0 , 6 ) );
+
+    // half a turn is still 22 wide
+    canvas.pixelBufferClearAll();
+    canvas.orientationSet( PIMORONI_11X7MATRIX_ROTATE_180 );
+    TEST_ASSERT_EQUAL_UINT8( 22 , canvas.widthGet() );
+    canvas.pixelSet( 1 , 2 , 1 );
+    TEST_ASSERT_EQUAL_UINT8( 1 , right.pixelGet( 9 , 4 ) );
+
+}
+
+
+// reads a column back out of the pixel buffer, bit 0 at the bottom.
+uint8_t columnGet( Pimoroni_11x7matrix &matrix , uint8_t xpos ) {
+
+    uint8_t mask = 0x00;
+
+    for ( uint8_t y = 0 ; y < 7 ; y++ ) { mask |= ( matrix.pixelGet( xpos , y ) << y ); }
+
+    return mask;
+
+}
+
+
+// glyphs land a column at a time, clipped at either side, over their own box only.
+void test_text() {
+
+    Pimoroni_11x7matrix matrix;
+    matrix.begin( 0x75 );
+
+    Pimoroni_11x7matrixText text( matrix );
+
+    // a 5x7 letter and the gap after it
+    matrix.pixelBufferStateFill( 0x7F );
+    TEST_ASSERT_EQUAL_INT( 6 , text.charDraw( 0 , 0 , 'A' ) );
+    TEST_ASSERT_EQUAL_HEX8( 0x3F , columnGet( matrix , 0 ) );
+    TEST_ASSERT_EQUAL_HEX8( 0x44 , columnGet( matrix , 2 ) );
+    TEST_ASSERT_EQUAL_HEX8( 0x3F , columnGet( matrix , 4 ) );
+    TEST_ASSERT_EQUAL_HEX8( 0x00 , columnGet( matrix , 5 ) );
+    TEST_ASSERT_EQUAL_HEX8( 0x7F , columnGet( matrix , 6 ) );
+
+    // off the left hand edge
+    matrix.pixelBufferClearAll();
+    TEST_ASSERT_EQUAL_INT( 9 , text.stringDraw( -3 , 0 , "HI" ) );
+    TEST_ASSERT_EQUAL_HEX8( 0x08 , columnGet( matrix , 0 ) );
+    TEST_ASSERT_EQUAL_HEX8( 0x7F , columnGet( matrix , 1 ) );
+    TEST_ASSERT_EQUAL_HEX8( 0x00 , columnGet( matrix , 2 ) );
+    TEST_ASSERT_EQUAL_HEX8( 0x41 , columnGet( matrix , 4 ) );
+    TEST_ASSERT_EQUAL_HEX8( 0x7F , columnGet( matrix , 5 ) );
+
+    // drawing the same again changes nothing, so nothing is sent
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.pixelBufferWriteAllToFrame( 0 ) );
+    text.stringDraw( -3 , 0 , "HI" );
+    Wire.statsReset();
+    TEST_ASSERT_EQUAL_UINT8( PIMORONI_11X7MATRIX_OK , matrix.pixelBufferWriteAllToFrame( 0 ) );
+    TEST_ASSERT_EQUAL_UINT32( 0 , Wire.statsGet().byteswritten );
+
+    // measuring
+    TEST_ASSERT_EQUAL_UINT16( 11 , text.stringWidthGet( "Hi" ) );
+    TEST_ASSERT_EQUAL_UINT16( 0 , text.stringWidthGet( "" ) );
+    text.fontSet( pimoroni_11x7matrixFontVariable );
+    TEST_ASSERT_EQUAL_UINT16( 9 , text.stringWidthGet( "Hi" ) );
+    TEST_ASSERT_EQUAL_UINT8( 2 , text.charWidthGet( ' ' ) );
+    TEST_ASSERT_EQUAL_UINT8( text.charWidthGet( '?' ) , text.charWidthGet( '\x01' ) );
+
+    // a 3x5 letter only covers its 5 rows
+    text.fontSet( pimoroni_11x7matrixFont3x5 );
+    matrix.pixelBufferStateFill( 0x7F );
+    text.charDraw( 0 , 1 , 'I' );
+    TEST_ASSERT_EQUAL_HEX8( 0x63 , columnGet( matrix , 0 ) );
+    TEST_ASSERT_EQUAL_HEX8( 0x7F , columnGet( matrix , 1 ) );
+    TEST_ASSERT_EQUAL_HEX8( 0x41 , columnGet( matrix , 3 ) );
+
+    // and the pwm of what it lights, the right way up
+    matrix.pixelBufferClearAll();
+    matrix.orientationSet( PIMORONI_11X7MATRIX_ROTATE_180 );
+    text.fontSet( pimoroni_11x7matrixFont5x7 );
+    text.pwmSet( 0x40 );
+    text.charDraw( 6 , -2 , 'I' );
+    TEST_ASSERT_EQUAL_HEX8( 0x1F , columnGet( matrix , 8 ) );
+    TEST_ASSERT_EQUAL_UINT8( 0x40 , matrix.pixelpwmGet( 8 , 0 ) );
+    TEST_ASSERT_EQUAL_UINT8( 0x00 , matrix.pixelpwmGet( 8 , 5 ) );
+    TEST_ASSERT_EQUAL_UINT8( 0x40 , matrix.pixelpwmGet( 7 , 4 ) );
+    TEST_ASSERT_EQUAL_UINT8( 0x00 , matrix.pixelpwmGet( 6 , 2 ) );
+
+}
+
+
+
+
+int main( int argc , char **argv ) {
+
+    (void)( argc );
+    (void)( argv );
+
+    Wire.attach( chip );
+    Wire.attach( chipleft );
+
+    UNITY_BEGIN();
+
+    RUN_TEST( test_sim_page_select_and_auto_increment );
+    RUN_TEST( test_sim_read_only_and_clear_on_read );
+    RUN_TEST( test_sim_timing_model );
+    RUN_TEST( test_is31fl3731_burst );
+    RUN_TEST( test_is31fl3731_page_cache );
+    RUN_TEST( test_is31fl3731_setters_status );
+    RUN_TEST( test_matrix_begin );
+    RUN_TEST( test_matrix_resume_keeps_interrupt );
+    RUN_TEST( test_matrix_pixel_upload );
+    RUN_TEST( test_matrix_column_order );
+    RUN_TEST( test_matrix_missing_chip );
+    RUN_TEST( test_matrix_frame_readback );
+    RUN_TEST( test_matrix_control_readback );
+    RUN_TEST( test_matrix_timeout_recover );
+    RUN_TEST( test_pusher_stream );
+    RUN_TEST( test_matrix_control_write_failure );
+    RUN_TEST( test_matrix_update_commit );
+    RUN_TEST( test_matrix_instrumentation );
+    RUN_TEST( test_matrix_double_buffer );
+    RUN_TEST( test_matrix_brightness_only );
+    RUN_TEST( test_matrix_gamma );
+    RUN_TEST( test_matrix_orientation );
+    RUN_TEST( test_draw_shapes );
+    RUN_TEST( test_text );
+    RUN_TEST( test_player_stream );
+    RUN_TEST( test_framepool_lru );
+    RUN_TEST( test_canvas_tiles );
+    RUN_TEST( test_canvas_orientation );
+
+    return UNITY_END();
+
+}